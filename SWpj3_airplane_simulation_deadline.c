@@ -0,0 +1,953 @@
+#include <stdint.h> // uint8_t를 사용하기 위해 추가 (1byte)
+#include <stdio.h>
+#include <stdlib.h> // malloc
+#include <time.h>
+
+#include "SWpj3_rng.h" // 난수 (Philox, --seed)
+
+#define SIMULATION_DONE 500     // 시뮬레이션 횟수
+#define MAX_PLANE_COUNT 1000000 // 최대 공존 가능 비행기 수
+// #define LANDING_Q_COUNT 4       // 착륙 큐 개수
+// #define TAKEOFF_Q_COUNT 3       // 이륙 큐 개수
+// #define RUNWAY_COUNT 3          // 활주로 개수
+#define LANDING_Q_COUNT 8 // 착륙 큐 개수
+#define TAKEOFF_Q_COUNT 5 // 이륙 큐 개수
+#define RUNWAY_COUNT 5    // 활주로 개수
+#define TAKEOFF_ONLY 4    // 이륙 전용 활주로 설정 (idx로 지정)
+
+#define WHEEL_BITS 6                 // 타이밍 휠 한 단계 칸 수: 2^6 = 64
+#define WHEEL_SIZE (1 << WHEEL_BITS) // 64
+#define WHEEL_MASK (WHEEL_SIZE - 1)  // 칸 idx 계산용
+#define WHEEL_LEVELS 5               // 64^5 = 2^30 tick 이후 소진까지 표현 가능
+
+#define POLICY_FIFO 0              // 일반 착륙: 가장 긴 큐의 맨 앞 비행기
+#define POLICY_URGENT 1            // 일반 착륙: 남은 비행 가능 시간이 가장 짧은 비행기 (min-heap)
+#define LANDING_POLICY POLICY_FIFO // 착륙 스케줄링 정책
+
+//@ TAKEOFF_ONLY 여러개 설정법 (활주로 idx 목록, 시작 시 비트마스크로 변환)
+// #define MAX_TAKEOFF_ONLY 3
+// const int takeoff_only_rw[MAX_TAKEOFF_ONLY] = {1,3,5};
+#define MAX_TAKEOFF_ONLY 1
+const int takeoff_only_rw[MAX_TAKEOFF_ONLY] = {TAKEOFF_ONLY};
+
+#define RW_WORDS ((RUNWAY_COUNT + 63) / 64) // 활주로 비트마스크 워드 수 (64개 넘어도 가능)
+
+//@ 공간 복잡도 개선 사항
+// todo: Plane을 Takeoff_Plane, Landing_Plane 으로 구분 + [중요] pool도 나눠야 함
+// todo: >> 메모리를 아낄 수 있음 (fuel, consume: 8byte save)
+// todo: >> 스레드 2개는 비효율적
+// todo: uint16_t: 2byte, uint32_t: 4byte 메모리 낭비 조절
+
+//@ 시간 복잡도 개선 사항
+// todo: thread 세부 분할? > lock 적용 비효율 생각해야 함
+// todo: tree?
+
+// 4*3 + 1*2 = 14 >> 16바이트 정렬
+// int만 사용하는 것 보다 16바이트 세이브 가능
+//+ type을 없앨 수도 있음 (홀수: lsb=1, 짝수: lsb=0)
+typedef struct Plane {
+    int idx;       // 비행기 식별번호(착륙: 짝수, 이륙: 홀수)
+    int fuel;      // 비행기 연료
+    int entryTime; // 큐 진입 시간(통계)
+    int consume;   // 연료 소모 속도
+    int type;      // 착륙: 0, 이륙: 1 (idx를 이용한 비교X)
+} Plane;
+
+// Plane 구조체의 next보다는 Node 구조체를 따로 빼서 next를 하는게 논리적
+//@ deadline 모델: 연료는 매 tick 일정하게 감소 >> 생성 시점에 연료 소진 tick(crashTick)이 정해짐
+// plane.fuel은 큐 진입 시 연료 그대로 두고, 필요할 때(착륙/출력)만 fuel_at()으로 계산
+// >> 매 tick 큐 안의 비행기를 건드리지 않음
+typedef struct Node {
+    Plane plane;
+    struct Node *next;       // 큐 FIFO 연결
+    struct Node *prev;       // 큐 중간 삭제(긴급)를 O(1)로 하기 위한 역방향 연결
+    struct Node *due_next;   // 같은 휠 칸 비행기끼리 연결
+    struct Node **due_pprev; // 앞 노드의 due_next (또는 칸 head) 주소 >> 어느 칸인지 몰라도 O(1) 삭제
+    int crashTick;           // 연료가 0 이하가 되는 tick
+    int q_idx;               // 속한 착륙 큐 (긴급 처리 순서 재현용)
+    int seq;                 // 큐 진입 순서 (긴급 처리 순서 재현용)
+    int heap_pos;            // urgent heap 안의 위치 (중간 삭제 O(log n))
+} Node;
+
+// 착륙 긴급도 min-heap (crashTick이 가장 빠른 비행기가 root)
+// 노드가 자기 위치(heap_pos)를 알고 있어 긴급/착륙으로 빠질 때 O(log n) 삭제
+typedef struct Urgent_heap {
+    Node **arr;
+    int size;
+    int cap;
+} UrgentHeap;
+
+// 착륙 큐, 이륙 큐
+typedef struct Queue {
+    Node *head;                // 삭제 수행
+    Node *tail;                // 삽입 수행
+    int size;                  // 로드 밸런싱
+    struct Queue_index *index; // 크기 변경 시 갱신할 큐 선택 인덱스 (NULL: 없음)
+    int pos;                   // 인덱스 안에서의 큐 idx
+} Queue;
+
+// 활주로 상태 비트마스크 (활주로 i = w[i / 64]의 i % 64번 비트)
+// 빈 활주로 수: popcount, 빈 활주로 순회: ctz >> 매 tick 배열 재구성 없음
+typedef struct Runway_mask {
+    uint64_t w[RW_WORDS];
+} RunwayMask;
+
+// 큐 선택 인덱스 (토너먼트 트리)
+// 리프 = 큐 idx, 내부 노드 = 구간에서 가장 짧은/긴 큐 idx (동률이면 작은 idx: 기존 선형 탐색과 동일)
+// >> 가장 짧은/긴 큐: root 조회 O(1), 크기 변경: 부모 쪽으로 O(log Q) 갱신, 전체 크기: 누적 O(1)
+typedef struct Queue_index {
+    Queue *q;      // 대상 큐 배열
+    int n;         // 큐 개수
+    int leaves;    // 리프 수 (n 이상인 2의 거듭제곱)
+    int *min_tree; // 1번부터 사용, 빈 리프는 -1
+    int *max_tree;
+    int total;     // 전체 큐 크기 합
+} QueueIndex;
+
+// 긴급 리스트 ()
+typedef struct Stack {
+    Node *top; // LIFO pointer
+    int size;  // 통계?
+} EmergencyStack;
+
+//// 스레드 공유 자원
+Node pool[MAX_PLANE_COUNT]; // malloc의 연산 부하 해결
+Node *freed_head = pool;    // 해제된 리스트의 헤드(가용 가능한 청크)
+// pthread_mutex_t poolMutex = PTHREAD_MUTEX_INITIALIZER;
+
+Queue landingQ[LANDING_Q_COUNT]; // 착륙 큐
+Queue takeoffQ[TAKEOFF_Q_COUNT]; // 이륙 큐
+QueueIndex landingIdx;           // 착륙 큐 선택 인덱스
+QueueIndex takeoffIdx;           // 이륙 큐 선택 인덱스
+RunwayMask rw_all;               // 전체 활주로
+RunwayMask rw_takeoff_only;      // 이륙 전용 활주로
+RunwayMask rw_landing_ok;        // 착륙 가능 활주로 (전체 - 이륙 전용)
+EmergencyStack emergS;
+Node *wheel[WHEEL_LEVELS][WHEEL_SIZE]; // 연료 소진 tick 계층 타이밍 휠
+int wheel_now = 0;                     // 휠이 마지막으로 처리한 tick
+UrgentHeap urgentH;                    // LANDING_POLICY == POLICY_URGENT 일 때만 사용
+////
+
+//@ 매 시간 단위마다 집계하기 위한 변수
+int g_total_emergency_plane_count = 0; //* 긴급 착륙을 시행한 모든 비행기의 수와 비율
+int g_total_plane_count = 0;           //* 생성 비행기 수
+int g_total_crashed_plane_count = 0;   //* 사고 당한 모든 비행기의 수와 비율
+
+int g_total_landed_count = 0;
+
+double g_total_runway_time = 0.0; // 활주로 배정 단계 시간 (정책 비교, tick당 1번 측정)
+long g_pick_count = 0;            // 일반 착륙 비행기 선택 수
+
+// next를 다음 주소와 연결해주는 작업 (리스트의 장점: 삭제 연산)
+void init_pool(void) {
+    // 마지막 idx직전까지 연결, next는 포인터: 주소를 연결
+    for (int i = 0; i < MAX_PLANE_COUNT - 1; i++) {
+        pool[i].next = &pool[i + 1];
+    }
+    // 마지막 idx는 next가 NULL이어야 함.
+    pool[MAX_PLANE_COUNT - 1].next = NULL;
+}
+
+// LIFO 구조 노드 반환
+Node *alloc_node(void) {
+    // 가용 가능한 청크가 없는 경우(다 씀)
+    if (freed_head == NULL) {
+        printf("freed_head is NULL (FULL MEMORY)\n");
+        return NULL;
+    }
+
+    // 하나씩 가져가며 pool은 줄어듦.
+    Node *newNode = freed_head;
+    freed_head = freed_head->next;
+
+    // 배열에서 떼어내 연결리스트로 사용할 것이기 때문에 기존 연결을 끊어줘야 함.
+    newNode->next = NULL;
+    return newNode;
+}
+
+// LIFO 구조 노드 해제 및 재사용을 위한 연결
+void free_node(Node *temp) {
+    // 해제된 청크를 다시 사용 (LIFO)
+    temp->next = freed_head;
+    freed_head = temp;
+}
+
+// FIFO 구조 큐 초기화
+void init_queue(Queue *queue) {
+    queue->head = NULL;
+    queue->tail = NULL;
+    queue->size = 0;
+    queue->index = NULL;
+    queue->pos = 0;
+}
+
+//@ 큐 선택 인덱스
+// 두 후보 중 더 짧은 큐 (동률이면 a: 왼쪽 = 작은 idx)
+int qindex_min_pick(QueueIndex *ix, int a, int b) {
+    if (a < 0)
+        return b;
+    if (b < 0)
+        return a;
+    return (ix->q[b].size < ix->q[a].size) ? b : a;
+}
+
+// 두 후보 중 더 긴 큐 (동률이면 a)
+int qindex_max_pick(QueueIndex *ix, int a, int b) {
+    if (a < 0)
+        return b;
+    if (b < 0)
+        return a;
+    return (ix->q[b].size > ix->q[a].size) ? b : a;
+}
+
+// 큐 pos의 크기가 바뀌었을 때 root까지 갱신
+void qindex_update(QueueIndex *ix, int pos) {
+    for (int i = (ix->leaves + pos) / 2; i >= 1; i /= 2) {
+        ix->min_tree[i] = qindex_min_pick(ix, ix->min_tree[2 * i], ix->min_tree[2 * i + 1]);
+        ix->max_tree[i] = qindex_max_pick(ix, ix->max_tree[2 * i], ix->max_tree[2 * i + 1]);
+    }
+}
+
+// 인덱스 생성 (큐 초기화 후 호출)
+void init_queue_index(QueueIndex *ix, Queue *q, int n) {
+    ix->q = q;
+    ix->n = n;
+    ix->leaves = 1;
+    while (ix->leaves < n)
+        ix->leaves *= 2;
+    ix->min_tree = malloc(2 * ix->leaves * sizeof(int));
+    ix->max_tree = malloc(2 * ix->leaves * sizeof(int));
+    ix->total = 0;
+
+    for (int i = 0; i < ix->leaves; i++) {
+        int leaf = (i < n) ? i : -1;
+        ix->min_tree[ix->leaves + i] = leaf;
+        ix->max_tree[ix->leaves + i] = leaf;
+    }
+    for (int i = ix->leaves - 1; i >= 1; i--) {
+        ix->min_tree[i] = qindex_min_pick(ix, ix->min_tree[2 * i], ix->min_tree[2 * i + 1]);
+        ix->max_tree[i] = qindex_max_pick(ix, ix->max_tree[2 * i], ix->max_tree[2 * i + 1]);
+    }
+    for (int i = 0; i < n; i++) {
+        q[i].index = ix;
+        q[i].pos = i;
+        ix->total += q[i].size;
+    }
+}
+
+// enqueue/dequeue/중간 삭제 후 호출: 전체 크기 누적 + 트리 갱신
+void queue_size_changed(Queue *queue, int delta) {
+    if (queue->index == NULL)
+        return;
+    queue->index->total += delta;
+    qindex_update(queue->index, queue->pos);
+}
+
+// FIFO 구조 큐 삽입
+void enqueue(Queue *queue, Node *temp) {
+    temp->prev = queue->tail;
+    if (queue->tail == NULL) {
+        // tail에 아무것도 없는 경우
+        queue->head = temp; //head 조정
+        queue->tail = temp;
+        queue->size++;
+        queue_size_changed(queue, 1);
+        return;
+    }
+    temp->next = NULL; // 기존 연결이 있을 수 있으니 해제
+    queue->tail->next = temp;
+    queue->tail = temp;
+    queue->size++;
+    queue_size_changed(queue, 1);
+}
+
+// FIFO 구조 큐 삭제
+Node *dequeue(Queue *queue) {
+    if (queue->head == NULL)
+        return NULL; // head에 아무것도 없는 경우
+
+    Node *node = queue->head;
+    queue->head = queue->head->next;
+
+    if (queue->head == NULL)
+        queue->tail = NULL; // tail 조정
+    else
+        queue->head->prev = NULL;
+    queue->size--;
+    queue_size_changed(queue, -1);
+
+    return node;
+}
+
+// 큐 중간 노드 삭제 (prev 연결로 O(1))
+void remove_from_queue(Queue *queue, Node *node) {
+    if (node->prev == NULL)
+        queue->head = node->next;
+    else
+        node->prev->next = node->next;
+
+    if (node->next == NULL)
+        queue->tail = node->prev;
+    else
+        node->next->prev = node->prev;
+    queue->size--;
+    queue_size_changed(queue, -1);
+}
+
+//@ 연료 소진 tick 계산
+// 착륙 비행기가 해당 tick에 가진 연료 (그 tick의 연료 감소까지 반영)
+// 진입한 tick부터 매 tick consume씩 감소
+int fuel_at(Plane *plane, int tick) {
+    return plane->fuel - plane->consume * (tick - plane->entryTime + 1);
+}
+
+// 연료가 처음으로 0 이하가 되는 tick: entryTime - 1 + ceil(fuel / consume)
+int get_crash_tick(Plane *plane) {
+    return plane->entryTime - 1 + (plane->fuel + plane->consume - 1) / plane->consume;
+}
+
+//@ 계층 타이밍 휠 (calendar queue)
+// level k 칸 하나 = 64^k tick 범위, 남은 시간(crashTick - wheel_now)에 맞는 level에 삽입
+// 매 tick level 0 칸 하나만 꺼내고, 하위 level이 한 바퀴 돌 때마다 상위 칸을 한 단계 아래로 내림(cascade)
+// >> 고정 메모리는 칸 5*64개, 노드마다 due_next + due_pprev 16byte (72byte 노드: 이전 달력 연결과 같은 크기)
+// >> deadline 변형 전용: save_mem(12byte 노드)에 넣으면 연결 + crashTick만으로 노드 크기가 2배 가까이 됨
+
+// 칸 맨 앞에 연결
+void wheel_link(Node **slot, Node *node) {
+    node->due_next = *slot;
+    node->due_pprev = slot;
+    if (*slot != NULL)
+        (*slot)->due_pprev = &node->due_next;
+    *slot = node;
+}
+
+// 휠에 추가
+void due_insert(Node *node) {
+    int delta = node->crashTick - wheel_now;
+    for (int level = 0; level < WHEEL_LEVELS; level++) {
+        if (delta < (1 << (WHEEL_BITS * (level + 1)))) {
+            int slot = (node->crashTick >> (WHEEL_BITS * level)) & WHEEL_MASK;
+            wheel_link(&wheel[level][slot], node);
+            return;
+        }
+    }
+    printf("crashTick is out of wheel range.\n");
+    exit(-1);
+}
+
+// 휠에서 삭제 (일반 착륙 시)
+void due_remove(Node *node) {
+    *node->due_pprev = node->due_next;
+    if (node->due_next != NULL)
+        node->due_next->due_pprev = node->due_pprev;
+}
+
+// 상위 level 칸 하나를 통째로 떼어 남은 시간 기준으로 다시 삽입 (하위 level로 내려감)
+void wheel_cascade(int level, int slot) {
+    Node *curr = wheel[level][slot];
+    wheel[level][slot] = NULL;
+    while (curr != NULL) {
+        Node *next = curr->due_next;
+        due_insert(curr);
+        curr = next;
+    }
+}
+
+// tick 진행: 휠 시간을 맞추고 상위 level부터 cascade 후 이번 tick 칸(level 0)을 통째로 반환
+Node *wheel_advance(int tick) {
+    wheel_now = tick;
+    for (int level = WHEEL_LEVELS - 1; level > 0; level--) {
+        // 하위 level 전체가 한 바퀴 돈 시점에만 수행
+        if ((tick & ((1 << (WHEEL_BITS * level)) - 1)) == 0)
+            wheel_cascade(level, (tick >> (WHEEL_BITS * level)) & WHEEL_MASK);
+    }
+
+    Node **slot = &wheel[0][tick & WHEEL_MASK];
+    Node *due_head = *slot;
+    *slot = NULL;
+    return due_head;
+}
+
+//@ urgent heap
+// 먼저 소진되는 비행기 우선, 같으면 먼저 들어온 비행기 우선
+int heap_less(Node *a, Node *b) {
+    if (a->crashTick != b->crashTick)
+        return a->crashTick < b->crashTick;
+    return a->seq < b->seq;
+}
+
+void heap_set(UrgentHeap *h, int pos, Node *node) {
+    h->arr[pos] = node;
+    node->heap_pos = pos;
+}
+
+void heap_sift_up(UrgentHeap *h, int pos) {
+    Node *node = h->arr[pos];
+    while (pos > 0) {
+        int parent = (pos - 1) / 2;
+        if (!heap_less(node, h->arr[parent]))
+            break;
+        heap_set(h, pos, h->arr[parent]);
+        pos = parent;
+    }
+    heap_set(h, pos, node);
+}
+
+void heap_sift_down(UrgentHeap *h, int pos) {
+    Node *node = h->arr[pos];
+    while (1) {
+        int child = 2 * pos + 1;
+        if (child >= h->size)
+            break;
+        if (child + 1 < h->size && heap_less(h->arr[child + 1], h->arr[child]))
+            child++;
+        if (!heap_less(h->arr[child], node))
+            break;
+        heap_set(h, pos, h->arr[child]);
+        pos = child;
+    }
+    heap_set(h, pos, node);
+}
+
+void heap_push(UrgentHeap *h, Node *node) {
+    if (h->size == h->cap) {
+        h->cap = h->cap ? h->cap * 2 : 1024;
+        Node **grown = realloc(h->arr, h->cap * sizeof(Node *));
+        if (grown == NULL) {
+            printf("urgent heap realloc failed (FULL MEMORY)\n");
+            exit(-1);
+        }
+        h->arr = grown;
+    }
+    heap_set(h, h->size++, node);
+    heap_sift_up(h, node->heap_pos);
+}
+
+// 임의 위치 삭제: 마지막 노드로 채운 뒤 위/아래 중 맞는 방향으로 이동
+void heap_remove(UrgentHeap *h, Node *node) {
+    int pos = node->heap_pos;
+    Node *last = h->arr[--h->size];
+    if (pos == h->size)
+        return; // 마지막 노드였던 경우
+
+    heap_set(h, pos, last);
+    if (pos > 0 && heap_less(last, h->arr[(pos - 1) / 2]))
+        heap_sift_up(h, pos);
+    else
+        heap_sift_down(h, pos);
+}
+
+// 착륙 큐 삭제 + 휠 삭제
+Node *dequeue_landing(Queue *queue) {
+    Node *node = dequeue(queue);
+    if (node != NULL) {
+        due_remove(node);
+        if (LANDING_POLICY == POLICY_URGENT)
+            heap_remove(&urgentH, node);
+    }
+    return node;
+}
+
+// 가장 짧은 큐의 인덱스 반환 (비행기 생성 시 사용): 토너먼트 트리 root O(1)
+int get_shortest_queue_idx(QueueIndex *ix) {
+    return ix->min_tree[1];
+}
+
+// 이/착륙 비행기 생성 및 큐 삽입 & 생성 비행기 수 집계
+int generate_planes(int entryTime) {
+    static int land_idx = 2; // 착륙: 짝수 정수
+    static int take_idx = 1; // 이륙: 홀수 정수
+    static int seq = 0;      // 착륙 큐 진입 순서
+
+    // 난수는 multi_thread와 같은 스트림 (SWpj3_rng.h) >> 같은 --seed면 변형끼리 출력 diff 가능
+    Rng arrival = rng_stream(RNG_ARRIVAL, entryTime, 0);    // sub 0: 균등 도착 수 (이/착륙 공용)
+    int land_planes_cnt = rng_range(rng_next(&arrival), 6); // 0~5
+    int take_planes_cnt = rng_range(rng_next(&arrival), 6);
+
+    g_total_plane_count += (land_planes_cnt + take_planes_cnt); // 생성 비행기 수 집계
+
+    int landingQ_idx = get_shortest_queue_idx(&landingIdx); // 짧은 큐 한 번 구해서 그냥 다 넣기 (비행기 수 적을 때)
+    int takeoffQ_idx = get_shortest_queue_idx(&takeoffIdx);
+
+    // 착륙 비행기 정보 기입
+    for (int i = 0; i < land_planes_cnt; i++) {
+        uint32_t r[4];
+        rng_block(RNG_LANDING_PLANE, entryTime, 0, i, r); // 비행기마다 블록 1개 (tick 내 순번 i)
+        Node *newNode = alloc_node(); // Node 할당
+        newNode->plane.idx = land_idx;
+        newNode->plane.fuel = rng_range(r[0], 49) + 20;  // 20~68
+        newNode->plane.entryTime = entryTime;            // 생성 시점(통계)
+        newNode->plane.consume = rng_range(r[1], 3) + 3; // 1~3: 0이 되면 안됨
+        newNode->plane.type = 0;                         // 착륙: 0
+        newNode->crashTick = get_crash_tick(&newNode->plane);
+        newNode->q_idx = landingQ_idx;
+        newNode->seq = seq++;
+
+        // int landingQ_idx = get_shortest_queue_idx(landingQ, LANDING_Q_COUNT); // 연산 수 증가
+        land_idx += 2;
+        enqueue(&landingQ[landingQ_idx], newNode); // 착륙 큐 삽입
+        due_insert(newNode);                       // 연료 소진 tick 휠 삽입
+        if (LANDING_POLICY == POLICY_URGENT)
+            heap_push(&urgentH, newNode); // 긴급도 heap 삽입
+    }
+    //이륙 비행기 정보 기입
+    for (int i = 0; i < take_planes_cnt; i++) {
+        Node *newNode = alloc_node();
+        newNode->plane.idx = take_idx;
+        newNode->plane.entryTime = entryTime;
+        newNode->plane.type = 1; //이륙: 1
+
+        // int takeoffQ_idx = get_shortest_queue_idx(takeoffQ, TAKEOFF_Q_COUNT); // 연산 수 증가
+        take_idx += 2;
+
+        enqueue(&takeoffQ[takeoffQ_idx], newNode); // 이륙 큐 삽입
+    }
+}
+
+// 스택 초기화
+void init_emergency_stack(EmergencyStack *s) {
+    s->top = NULL;
+    s->size = 0;
+}
+
+//-- 멀티 스레드의 경우 lock 필요
+// 스택 push
+void push_emergency(EmergencyStack *s, Node *emerg) {
+    // 사실상 LIFO 구조의 연결리스트
+    emerg->next = s->top; // 긴급한 비행기끼리 연결
+    s->top = emerg;
+    s->size++;
+}
+
+// 스택 전체 리스트 pop (하나씩 빼 줄 필요X -> lock 필요X)
+Node *pop_all_emergency(EmergencyStack *s) {
+
+    if (s->top == NULL)
+        return NULL; // 긴급 착륙 비행기가 없던 경우
+
+    // EmergencyStack *emerg_all_copy = s; // 동일한 객체를 가리켜 의미X
+    Node *emerg_head = s->top;
+
+    // 다음 tick을 위한 초기화
+    s->top = NULL;
+    s->size = 0;
+
+    return emerg_head;
+}
+
+// 긴급 처리 순서 비교: (큐 idx, 큐 진입 순서) 오름차순
+int cmp_queue_order(const void *a, const void *b) {
+    Node *x = *(Node **)a;
+    Node *y = *(Node **)b;
+    if (x->q_idx != y->q_idx)
+        return x->q_idx - y->q_idx;
+    return x->seq - y->seq;
+}
+
+//// 연료 소진 감지 (큐 전체 순회X, 이번 tick 휠 칸 하나만 확인)
+// 기존 모델은 큐 0번부터 앞에서부터 훑으며 긴급 스택에 push
+// >> 같은 순서로 push해야 긴급 착륙 3대가 같아짐 (출력 동일)
+void check_due_emergency(int tick) {
+    static Node **buf = NULL; // 이번 tick 긴급 비행기 정렬용
+    static int buf_cap = 0;
+
+    int count = 0;
+    for (Node *curr = wheel_advance(tick); curr != NULL; curr = curr->due_next) {
+        if (count == buf_cap) {
+            buf_cap = buf_cap ? buf_cap * 2 : 64;
+            Node **grown = realloc(buf, buf_cap * sizeof(Node *));
+            if (grown == NULL) {
+                printf("due buffer realloc failed (FULL MEMORY)\n");
+                exit(-1);
+            }
+            buf = grown;
+        }
+        buf[count++] = curr;
+    }
+
+    qsort(buf, count, sizeof(Node *), cmp_queue_order);
+    for (int i = 0; i < count; i++) {
+        Node *emergency = buf[i];
+        //@ unlink
+        remove_from_queue(&landingQ[emergency->q_idx], emergency);
+        if (LANDING_POLICY == POLICY_URGENT)
+            heap_remove(&urgentH, emergency);
+        emergency->plane.fuel = fuel_at(&emergency->plane, tick); // 떠나는 비행기만 연료 계산
+        //@ link
+        push_emergency(&emergS, emergency);
+    }
+}
+
+// 벽시계 시간(sec) 반환 (멀티 스레드 버전과 같은 기준으로 비교)
+double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+//@ 활주로 비트마스크
+void rw_set(RunwayMask *m, int rw) {
+    m->w[rw / 64] |= (uint64_t)1 << (rw % 64);
+}
+
+void rw_clear(RunwayMask *m, int rw) {
+    m->w[rw / 64] &= ~((uint64_t)1 << (rw % 64));
+}
+
+int rw_test(RunwayMask *m, int rw) {
+    return (m->w[rw / 64] >> (rw % 64)) & 1;
+}
+
+// 잔여 활주로 수 반환: >0, 0 (popcount)
+int is_there_remain_runway(RunwayMask *rw_free) {
+    int remainRW = 0;
+    for (int i = 0; i < RW_WORDS; i++)
+        remainRW += __builtin_popcountll(rw_free->w[i]);
+    return remainRW;
+}
+
+// 가장 뒤쪽 빈 활주로를 점유하고 idx 반환 (긴급 착륙: 마지막 활주로 우선), 없으면 -1
+int rw_take_highest(RunwayMask *rw_free) {
+    for (int i = RW_WORDS - 1; i >= 0; i--) {
+        if (rw_free->w[i] == 0)
+            continue;
+        int rw = i * 64 + 63 - __builtin_clzll(rw_free->w[i]);
+        rw_clear(rw_free, rw);
+        return rw;
+    }
+    return -1;
+}
+
+// 활주로 역할 마스크 생성 (시작 시 1번)
+void init_runway_masks(void) {
+    for (int i = 0; i < RUNWAY_COUNT; i++)
+        rw_set(&rw_all, i);
+    for (int i = 0; i < MAX_TAKEOFF_ONLY; i++)
+        rw_set(&rw_takeoff_only, takeoff_only_rw[i]);
+    for (int i = 0; i < RW_WORDS; i++)
+        rw_landing_ok.w[i] = rw_all.w[i] & ~rw_takeoff_only.w[i];
+}
+
+// 각 역할 큐 전체 사이즈 참조 비교 (call by ref: 배열 반환이 안되네..)
+// enqueue/dequeue 때 누적해 둔 값 사용 (큐 순회X)
+void get_total_queue_size(QueueIndex *landIx, QueueIndex *takeIx,
+                          int *l_total_landing_queue_size, int *l_total_takeoff_queue_size) {
+    *l_total_landing_queue_size += landIx->total;
+    *l_total_takeoff_queue_size += takeIx->total;
+}
+
+// 가장 긴 큐의 인덱스 반환 (이륙 시 사용): 토너먼트 트리 root O(1)
+int get_longest_queue_idx(QueueIndex *ix) {
+    return ix->max_tree[1];
+}
+
+// 일반 착륙할 비행기 선택 (LANDING_POLICY)
+// >> 선택 1번은 clock_gettime 한 번과 비슷한 수준이라 개별 측정X (활주로 단계 전체를 tick당 1번 측정)
+Node *pick_landing(void) {
+    Node *target;
+
+    if (LANDING_POLICY == POLICY_URGENT) {
+        // 가장 급한 비행기를 어느 큐에 있든 바로 꺼냄
+        target = (urgentH.size > 0) ? urgentH.arr[0] : NULL;
+        if (target != NULL) {
+            remove_from_queue(&landingQ[target->q_idx], target);
+            due_remove(target);
+            heap_remove(&urgentH, target);
+        }
+    }
+    else {
+        // 매 루프마다 가장 긴 큐를 탐색 (해당 mode의 큐를 모두 소모)
+        int landingQ_idx = get_longest_queue_idx(&landingIdx);
+        target = dequeue_landing(&landingQ[landingQ_idx]);
+    }
+
+    g_pick_count++;
+    return target;
+}
+
+/////////////////// main
+int main(int argc, char **argv) {
+    // 프로그램 시작하자마자 버퍼링 끄기
+    setbuf(stdout, NULL);
+
+    // 옵션: --seed N, --replication N (multi_thread와 같은 seed면 같은 비행기 생성)
+    if (rng_parse_args(argc, argv))
+        return -1;
+    // 풀 초기화
+    init_pool();
+    // 큐 초기화
+    for (int i = 0; i < LANDING_Q_COUNT; i++)
+        init_queue(&landingQ[i]);
+    for (int i = 0; i < TAKEOFF_Q_COUNT; i++)
+        init_queue(&takeoffQ[i]);
+    init_queue_index(&landingIdx, landingQ, LANDING_Q_COUNT);
+    init_queue_index(&takeoffIdx, takeoffQ, TAKEOFF_Q_COUNT);
+    // 활주로 역할 초기화
+    init_runway_masks();
+    // 긴급 스택 초기화
+    init_emergency_stack(&emergS);
+
+    //// 단일 스레드 소요시간 파악
+    double l_total_time = 0.0;
+
+    //// simulation run
+    // 틱 마다 한 작업만 수행 (활주로 마다)
+    for (int tick = 1; tick <= SIMULATION_DONE; tick++) {
+        printf("%d---------------------One loop start------------------------\n", tick);
+
+        int l_total_landing_latency = 0;     // 평균 착륙 대기시간 집계용
+        int l_total_landing_plane_count = 0; // 평균 착륙 대기시간 집계용
+
+        int l_total_takeoff_latency = 0;     // 평균 이륙 대기시간 집계용
+        int l_total_takeoff_plane_count = 0; // 평균 이륙 대기시간 집계용
+
+        int l_total_landing_remaining = 0; // 평균 남은 제한 시간 집계용
+
+        generate_planes(tick); // 0~3대 비행기 이/착륙 큐 삽입, tick: entryTime
+
+        RunwayMask rw_free = rw_all; // 활주로 초기화 (빈 활주로: 1)
+
+        //todo============================
+        //// 연료 소진 감지 & EmergencyStack 삽입 (큐 순회X)
+        double start_time = now_sec();
+        check_due_emergency(tick);
+        double end_time = now_sec();
+        l_total_time += end_time - start_time;
+        //todo============================
+
+        // 비행기 삽입 후 연산
+        // 스레드 종료 후 연산 (긴급 리스트로 빠진 놈까지 기억 중)
+        int l_total_landing_queue_size = 0;
+        int l_total_takeoff_queue_size = 0;
+        get_total_queue_size(&landingIdx, &takeoffIdx,
+                             &l_total_landing_queue_size, &l_total_takeoff_queue_size);
+
+        //// 긴급 착륙 & 추락 한 방에 처리
+        // 해당 분기를 통과하면 비어있을 경우 X
+        if (emergS.size > 0) {
+            Node *curr = pop_all_emergency(&emergS); // 스택 제거
+            if (curr == NULL) {
+                // 비어있을 수 없음 (emergS.size>0 이어서)
+                printf("Emergency Stack is not empty. But pop_all_emergency is NULL.\n");
+                return -1; // 뭔가 잘못됐으니 종료
+            }
+
+            int survived_plane_count = 0; // 최대 3
+
+            // loop 1번으로 개선
+            while (curr != NULL) {
+                // 긴급 리스트 중 3개만 착륙 (긴급은 이륙 전용 활주로도 사용, 마지막 활주로 우선)
+                int emerg_rw = (survived_plane_count < 3) ? rw_take_highest(&rw_free) : -1;
+                if (emerg_rw >= 0) { // 최대 3번 수행
+
+                    g_total_emergency_plane_count++; // 긴급 착륙한 비행기 집계
+                    l_total_landing_queue_size--;    // 착륙했으니 감소
+
+                    printf("[!] [EMERGENCY] ID: %d, RW: %d, Fuel: %d, Type: %d\n",
+                           curr->plane.idx, emerg_rw + 1,
+                           curr->plane.fuel, curr->plane.type);
+                    survived_plane_count++; //! 출력에서 survived.. 를 사용하기 때문에 출력 후 증가
+                }
+                // 긴급 스택이 3개 이상인 경우: 나머지 다 추락
+                else {
+                    // 추락한 비행기 집계
+                    g_total_crashed_plane_count++;
+                    l_total_landing_queue_size--; //추락했으니 감소
+                    printf("[X] [CRASHED] ID: %d, Fuel: %d\n", curr->plane.idx, curr->plane.fuel);
+                }
+                // 정리
+                Node *nextNode = curr->next; // 삭제 전 미리 저장
+                free_node(curr);
+                curr = nextNode; // curr == NULL 은 분기에서 처리 됨
+            }
+        }
+        else {
+            printf("Emerency Stack is empty.\n");
+        }
+
+        //// 일반 착륙 & 이륙 중 큐 길이가 긴 것 우선 처리
+        //? 활주로 개수만큼 큐 길이 확인 후 이/착륙 수행 비효율 > 한 번 확인 후 같은 동작 수행이 효율적일 듯 (활주로 적을 때 유효)
+        // 잔여 활주로가 있다면
+        double runway_start = now_sec();
+        if (is_there_remain_runway(&rw_free)) {
+
+            // 빈 활주로 위치: 비트마스크 사본을 ctz로 순회 (순회 중 rw_free는 바뀜)
+            RunwayMask remainRW = rw_free;
+
+            // 착륙: 1, 이륙: 0 (우선순위 편향을 위함)
+            int bias_mode = (l_total_landing_queue_size > l_total_takeoff_queue_size) ? 1 : 0;
+            Node *target = NULL;
+
+            // mode를 통해 우선순위를 두고 매번 긴 큐 탐색
+            for (int w = 0; w < RW_WORDS; w++) {
+                for (uint64_t bits = remainRW.w[w]; bits != 0; bits &= bits - 1) {
+                    int rw = w * 64 + __builtin_ctzll(bits); // 가장 앞쪽 빈 활주로
+
+                    int mode = bias_mode; // 편향 덮어쓰기 방지
+
+                    // 착륙 불가 활주로(이륙 전용)면 바로 이륙 프로세스 수행
+                    if (!rw_test(&rw_landing_ok, rw)) {
+                        mode = 0; // 얘가 mode를 바꿔줘야 하기 때문에 bias_mode 복사 사용
+                        int takeoffQ_idx = get_longest_queue_idx(&takeoffIdx);
+                        target = dequeue(&takeoffQ[takeoffQ_idx]);
+                        if (target == NULL) {
+                            printf("Takeoff is empty.\n");
+                            continue; // 해당 활주로는 이제 쓸 일 없으므로 스킵
+                        }
+                    }
+                    // 활주로가 범용이면 이/착륙 중 모드 우선 처리 (해당 큐를 모두 사용하면 다음 큐)
+                    else {
+                        // 착륙 모드면
+                        if (mode) {
+                            // 정책에 따라 착륙 비행기 선택 (해당 mode의 큐를 모두 소모)
+                            target = pick_landing();
+                            // 해당 mode의 모든 큐를 소모했으면 bias_mode 변경
+                            if (target == NULL) {
+                                printf("[?] Throw to TAKEOFF.\n");
+                                // 갱신 (target을 설정해서 전달할거임)
+                                int takeoffQ_idx = get_longest_queue_idx(&takeoffIdx);
+                                target = dequeue(&takeoffQ[takeoffQ_idx]);
+                                bias_mode = 0; // 편향 변경
+                                mode = bias_mode;
+                            }
+                        }
+                        // 이륙 모드면
+                        else {
+                            int takeoffQ_idx = get_longest_queue_idx(&takeoffIdx);
+                            target = dequeue(&takeoffQ[takeoffQ_idx]);
+                            // 해당 mode의 모든 큐를 소모했으면 bias_mode 변경
+                            if (target == NULL) {
+                                printf("[?] Throw to LANDING.\n");
+                                // 갱신 (target을 설정해서 전달할거임)
+                                target = pick_landing();
+                                bias_mode = 1; // 편향 변경
+                                mode = bias_mode;
+                            }
+                        }
+                    }
+
+                    // mode에 대한 적절한 처리
+                    // 착륙의 경우
+                    //! 이/착륙 큐가 모두 빈 경우: target == NULL인 경우 발생
+                    //! 이륙 전용 활주로의 경우: target == NULL인 경우 발생
+                    if (target != NULL) {
+                        if (mode) {
+                            int fuel = fuel_at(&target->plane, tick);                                  // 착륙 시점 연료 계산
+                            l_total_landing_remaining += (fuel / target->plane.consume);               // 남은 제한시간 집계
+                            l_total_landing_latency += (tick - target->plane.entryTime);               // 착륙 대기 시간 집계
+                            l_total_landing_queue_size--;                                              // 착륙했으니 감소
+                            l_total_landing_plane_count++;                                             // 착륙했으니 증가
+                            g_total_landed_count++;
+
+                            printf("[*] [LANDING] ID: %d, RW: %d, Fuel: %d, Type: %d\n",
+                                   target->plane.idx, rw + 1,
+                                   fuel, target->plane.type);
+                        }
+                        // 이륙의 경우
+                        else {
+                            l_total_takeoff_latency += (tick - target->plane.entryTime); // 이륙 대기 시간 집계
+                            l_total_takeoff_queue_size--;                                // 이륙했으니 감소
+                            l_total_takeoff_plane_count++;                               // 이륙했으니 증가
+
+                            printf("[*] [TAKEOFF] ID: %d, RW: %d, Type: %d\n",
+                                   target->plane.idx, rw + 1, target->plane.type);
+                        }
+                        // 공통작업이라 뺌
+                        rw_clear(&rw_free, rw);
+                        free_node(target);
+                    }
+                    else {
+                        printf("Takeoff, Landing is all empty.\n");
+                    }
+                }
+            }
+        } // 한 단위 종료
+        g_total_runway_time += now_sec() - runway_start;
+
+        printf("-----------------------One loop done------------------------\n");
+        // 평균 이륙 지연시간, 평균 착륙 지연시간
+        if (l_total_takeoff_plane_count == 0) {
+            printf("In this loop TAKEOFF none.\n");
+        }
+        else {
+            printf("[+] [Avg Takeoff Latency] %d\n",
+                   l_total_takeoff_latency / l_total_takeoff_plane_count);
+        }
+
+        // 평균 착륙
+        if (l_total_landing_plane_count == 0) {
+            printf("In this loop LANDING none.\n");
+        }
+        else {
+            printf("[+] [Avg Landing Latentcy] %d\n",
+                   l_total_landing_latency / l_total_landing_plane_count);
+            printf("[+] [Avg Remaining Time Limit] %d\n",
+                   l_total_landing_remaining / l_total_landing_plane_count);
+        }
+
+        // 활주로 점유 상태
+        printf("[+] [Runway Status] [");
+        for (int i = 0; i < RUNWAY_COUNT; i++) {
+            if (i == RUNWAY_COUNT - 1) {
+                printf(" %d", !rw_test(&rw_free, i));
+                break;
+            }
+            printf(" %d, ", !rw_test(&rw_free, i));
+        }
+        printf(" ]\n");
+
+        // 큐 상태
+        printf("[+] [Total Landing Queue Size] %d\n", l_total_landing_queue_size);
+        printf("[+] [Total Takeoff Queue Size] %d\n", l_total_takeoff_queue_size);
+        printf("\n[&] landed: %d, takeoff: %d, total: %d\n\n", g_total_landed_count,
+               l_total_takeoff_plane_count, g_total_plane_count);
+
+    } // 시뮬레이션 종료
+
+    printf("\n\n=============[ Simulation is done! Let's check it out! ]=============\n");
+    printf("[Total Emergency Landed]: %d\n", g_total_emergency_plane_count);
+    printf("[Total Crashed Planes] %d\n", g_total_crashed_plane_count);
+    if (g_total_plane_count == 0) {
+        printf("g_total_plane_count == 0.\n");
+    }
+    else {
+        printf("[Avg Emergency Landed] %lf\n", ((double)g_total_emergency_plane_count / g_total_plane_count * 100.0));
+        printf("[Avg Crashed Planes] %lf\n ", ((double)g_total_crashed_plane_count / g_total_plane_count * 100.0));
+    }
+
+    printf("====[deadline]====\n");
+    printf("Seed: %llu, Replication: %u\n", (unsigned long long)g_seed, g_replication);
+    printf("Avg Time: %.6f sec\n", l_total_time / SIMULATION_DONE);
+    printf("Landing Policy: %s, Crash Rate: %.4f%%, Avg Runway Phase: %.1f ns/tick (picks: %ld)\n",
+           (LANDING_POLICY == POLICY_URGENT) ? "URGENT" : "FIFO",
+           g_total_plane_count ? (double)g_total_crashed_plane_count / g_total_plane_count * 100.0 : 0.0,
+           g_total_runway_time / SIMULATION_DONE * 1e9, g_pick_count);
+}
+
+// int pthread_create(pthread_t* thread,
+// 										pthread_attr_t* attr, void* (*routine)(void*), void* arg);
+// - thread: 생성을 성공하면 그 쓰레드의 ID가 저장된다.
+// - attr: 쓰레드의 속성 객체, 기본 속성을 사용할 경우 NULL을 넣는다.
+// - routine: 스레드의 실행코드 영역
+// - arg: 스레드에게 전달할 인자를 담은 구조체의 포인터, Nullable.
+// - 반환값: 0, 0보다 작은 값
+// ------------------------------------------------------------------------------
+// void pthread_exit(void* retval)
+// - retval: 반환할 구조체의 포인터, Nullable
+// ------------------------------------------------------------------------------
+// int pthread_join(pthread_t thread, void** thread_return) : 0, 음수 에러코드
+// - thread: 기다릴 스레드ID
+// - thread_return: 반환하는 포인터가 저장되는 포인터 변수
+// ------------------------------------------------------------------------------
+// > **Lock 변수 선언 및 초기화 방법 2가지**
+// 1. 전역 변수로 선언 - **`pthread_mutex_t lock;`**
+// 2. 한 함수에서 선언 - **`pthread_mutex_init(&lock, NULL);
+// ------------------------------------------------------------------------------
+// 전역 lock 적용
+// pthread_mutex_lock(&lock);
+// for (i = 0; i < LOOP; i++){
+//   gdata += data;
+// }
+// pthread_mutex_unlock(&lock);
+
+//// 예상 문제? 큐 정렬,
\ No newline at end of file
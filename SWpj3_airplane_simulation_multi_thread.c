@@ -1,11 +1,22 @@
+#include <fcntl.h>     // open (trace)
+#include <math.h>      // 도착/연료 분포 샘플링
 #include <pthread.h>
+#include <sched.h>     // sched_yield (log backpressure)
+#include <stdarg.h>    // log_printf
+#include <stdatomic.h> // 긴급 스택 pop (exchange)
 #include <stdint.h> // uint8_t를 사용하기 위해 추가 (1byte)
 #include <stdio.h>
-#include <stdlib.h> // random
+#include <string.h> // memcpy
+#include <sys/mman.h> // mmap (node pool)
+#include <sys/uio.h> // writev (trace)
 #include <time.h>
+#include <unistd.h> // write
+
+#include "SWpj3_rng.h"   // 난수 (Philox, --seed)
+#include "SWpj3_trace.h" // 바이너리 트레이스 형식
 
 #define SIMULATION_DONE 500     // 시뮬레이션 횟수
-#define MAX_PLANE_COUNT 1000000 // 최대 공존 가능 비행기 수
+#define MAX_PLANE_COUNT (1 << 25) // 최대 공존 가능 비행기 수 (예약만, 페이지는 쓴 만큼만 커밋)
 // #define LANDING_Q_COUNT 4       // 착륙 큐 개수
 // #define TAKEOFF_Q_COUNT 3       // 이륙 큐 개수
 // #define RUNWAY_COUNT 3          // 활주로 개수
@@ -14,6 +25,62 @@
 #define RUNWAY_COUNT 5    // 활주로 개수
 #define TAKEOFF_ONLY 4    // 이륙 전용 활주로 설정 (idx로 지정)
 
+//@ 도착 모델 (tick당 이/착륙 비행기 수, 각각)
+#define ARRIVAL_UNIFORM 0 // 0 ~ ARRIVAL_MAX-1 균등 (기존)
+#define ARRIVAL_POISSON 1 // 평균 ARRIVAL_RATE 포아송
+#define ARRIVAL_MMPP 2    // 평상(ARRIVAL_RATE) <> 폭주(MMPP_BURST_RATE) 2상태 마르코프 변조 포아송
+#define ARRIVAL_DIURNAL 3 // 평균이 DIURNAL_PERIOD 주기로 변하는 포아송 (하루 일정)
+#define ARRIVAL_MODEL ARRIVAL_UNIFORM
+#define ARRIVAL_MAX 6           // ARRIVAL_UNIFORM 범위
+#define ARRIVAL_RATE 2.5        // 포아송 평균 (tick당)
+#define MMPP_BURST_RATE 25.0    // 폭주 상태 평균
+#define MMPP_P_ENTER 0.02       // tick당 평상 > 폭주 전이 확률
+#define MMPP_P_LEAVE 0.2        // tick당 폭주 > 평상 전이 확률
+#define DIURNAL_PERIOD 100      // 주기 (tick)
+#define DIURNAL_AMPLITUDE 0.8   // 평균 = ARRIVAL_RATE * (1 + A * sin(2π tick / PERIOD))
+#define GEN_BATCH_MAX (1 << 21) // tick당 최대 생성 수 (각각, 생성 배열 크기)
+
+//@ 착륙 비행기 연료 모델
+#define FUEL_UNIFORM 0 // 20~68 균등 (기존)
+#define FUEL_PARETO 1  // 파레토 (꼬리가 긴 분포)
+#define FUEL_MODEL FUEL_UNIFORM
+#define FUEL_PARETO_MIN 20    // 최소 연료
+#define FUEL_PARETO_ALPHA 1.5 // 꼬리 두께 (작을수록 큰 값이 자주)
+#define FUEL_CAP 100000       // 상한
+
+#define GEN_SPREAD_MIN 128    // 한 tick 생성 수가 이 이상이면 여러 큐에 고르게 배분 (미만: 가장 짧은 큐 하나)
+#define GEN_PARALLEL_MIN 8192 // 한 tick 생성 수가 이 이상이면 worker가 큐별로 나눠 생성
+
+#define CACHE_LINE_SIZE 64   // worker별 자원을 캐시 라인 단위로 분리 (false sharing 방지)
+#define QUEUE_LAYOUT_BENCH 0 // 1: 큐 배치(packed vs shard) 처리량 비교만 수행 후 종료
+#define BENCH_PLANES_PER_Q 2000
+#define BENCH_ROUNDS 2000
+
+//@ 출력 레벨 (벤치마크는 LOG_SUMMARY 이하: 상위 레벨 출력 코드 자체가 빠짐)
+#define LOG_SILENT 0  // 출력 없음
+#define LOG_SUMMARY 1 // 종료 요약만
+#define LOG_TICK 2    // + tick별 요약
+#define LOG_EVENT 3   // + 비행기별 이벤트 (기존 출력 전체)
+#define LOG_LEVEL LOG_EVENT
+#define LOG_BUF_SIZE (1 << 20)   // 출력 버퍼 (가득 차면 write 1번)
+#define LOG_LINE_MAX 256         // log_printf 한 번의 최대 길이
+#define LOG_ASYNC 1              // 1: writer 스레드가 포맷/write (main은 레코드만 넣음)
+#define LOG_RING_SIZE (1 << 14)  // 링 버퍼 레코드 수 (2의 거듭제곱)
+#define LOG_WRITER_IDLE_NS 50000 // 링이 비었을 때 writer 대기 시간
+#define LOG_BP_BLOCK 0 // 링이 가득 차면 main이 기다림 (출력 손실 없음)
+#define LOG_BP_DROP 1  // 버림
+#define LOG_BP_COUNT 2 // 버리고 개수만 집계
+#define LOG_BACKPRESSURE LOG_BP_BLOCK
+
+#define TRACE_ENABLE 0                  // 1: 바이너리 트레이스 기록 (SWpj3_trace_decode.c로 집계)
+#define TRACE_PATH "airplane_trace.bin" // 트레이스 파일 경로
+
+#define MAG_SIZE 64                                                  // 매거진 당 노드 수 (depot 교환 단위)
+#define POOL_THREAD_MAX (LANDING_Q_COUNT + 1)                        // 풀을 쓸 수 있는 스레드 수 (worker + main)
+#define MAG_FULL_COUNT ((MAX_PLANE_COUNT + MAG_SIZE - 1) / MAG_SIZE) // 노드를 담는 매거진 수
+#define MAG_COUNT (MAG_FULL_COUNT + 2 * POOL_THREAD_MAX + 1)         // 스레드마다 2개 + 교환용 빈 매거진 1개
+#define POOL_CACHE_MAX (2 * MAG_SIZE * POOL_THREAD_MAX)              // 스레드 캐시에 묶여 다른 스레드가 못 쓰는 최대 노드 수
+
 //@ TAKEOFF_ONLY 여러개 설정법
 // #define MAX_TAKEOFF_ONLY 3
 // const int takeoff_only_rw[MAX_TAKEOFF_ONLY] = {1,3,5};
@@ -53,26 +120,81 @@ typedef struct Queue {
     int size;   // 로드 밸런싱
 } Queue;
 
-// 긴급 리스트 ()
+// 긴급 리스트
+// worker는 자기 버퍼에만 쌓고, main이 합류 후 버퍼를 큐 순서대로 올림 >> push는 main 하나뿐 (CAS X, 경합 X)
+// pop은 exchange 1번으로 전체를 가져감
 typedef struct Stack {
-    Node *top;            // LIFO pointer
-    int size;             // 통계?
-    pthread_mutex_t lock; // 긴급 리스트
+    _Atomic(Node *) top; // LIFO pointer
+    int size;            // 통계?
+    long push_count;     // 통계: 전체 push 수
 } EmergencyStack;
 
-// 스레드 할당 자원
-typedef struct Thread_arg {
-    Queue *q;
-} Arg;
+// worker별 통계 (자주 갱신되므로 별도 캐시 라인)
+typedef struct Shard_stats {
+    _Alignas(CACHE_LINE_SIZE) long scanned; // 검사한 비행기 수
+    long emerg_found;                       // 발견한 긴급 비행기 수
+} ShardStats;
+
+// 스레드 할당 자원 (착륙 큐 1개 + worker 전용 자원)
+// Queue를 배열로 붙여두면 24byte라 여러 큐가 한 캐시 라인을 공유 >> worker끼리 라인을 뺏고 뺏김
+// 캐시 라인 정렬 + 패딩으로 worker마다 자기 라인만 쓰도록 분리
+typedef struct Queue_shard {
+    _Alignas(CACHE_LINE_SIZE) Queue q; // 담당 착륙 큐
+    double busy_time;                  // 이번 tick에 실제 연산한 시간 (dispatch overhead 계산용)
+    Node *emerg_top;                   // worker 전용 긴급 리스트 (LIFO, 공유 쓰기 없음)
+    Node *emerg_tail;                  // 병합 시 O(1) 연결을 위한 가장 먼저 들어온 노드
+    int emerg_size;                    // worker 전용 긴급 리스트 크기
+    ShardStats stats;                  // 통계 (다음 캐시 라인)
+} QueueShard;
+
+// 상주 스레드 풀 (매 tick마다 pthread_create/join 하지 않음)
+// start_barrier에서 대기하다가 main이 풀어주면 자기 큐를 처리하고 done_barrier에서 합류
+typedef struct Worker_pool {
+    pthread_t tid[LANDING_Q_COUNT];  // thread id (worker i는 착륙 큐 샤드 i 담당)
+    pthread_barrier_t start_barrier; // main + worker: tick 시작 신호
+    pthread_barrier_t done_barrier;  // main + worker: tick 종료 합류
+    volatile int quit;               // 1이면 worker 종료
+    volatile int job;                // 이번에 깨울 때 할 일 (WORK_FUEL, WORK_GENERATE)
+} WorkerPool;
+
+enum { WORK_FUEL, WORK_GENERATE };
+
+// 매거진: 노드 최대 MAG_SIZE개를 담은 LIFO 묶음 (스레드 캐시 <> depot 교환 단위)
+typedef struct Magazine {
+    struct Magazine *next; // depot 리스트 연결
+    Node *top;             // 노드 LIFO (next로 연결)
+    int count;             // 담긴 노드 수
+} Magazine;
+
+// depot: 전역 매거진 창고 (꽉 찬 것 / 빈 것)
+// >> lock은 매거진 교환 때만 (노드 MAG_SIZE개 당 최대 1번)
+typedef struct Depot {
+    Magazine *full;       // 노드가 있는 매거진 리스트
+    Magazine *empty;      // 빈 매거진 리스트
+    int carved;           // 매거진으로 잘라낸 pool 노드 수 (이후는 한 번도 안 쓴 영역)
+    int mag_used;         // 꺼내 쓴 매거진 구조체 수
+    long exchange_count;  // 통계: depot 교환 수
+    long fast_count;      // 통계: 교환 없이 처리한 alloc/free 수 (lock 밖에서 스레드별로 모아서 합산)
+    pthread_mutex_t lock; // depot 보호
+} Depot;
+
+// 스레드별 노드 캐시 (매거진 2개: 할당/해제가 경계에서 반복돼도 depot 왕복 방지)
+typedef struct Node_cache {
+    Magazine *loaded;   // 현재 alloc/free 하는 매거진
+    Magazine *previous; // 직전 매거진 (꽉 찼거나 비어 있음)
+    long fast_count;    // 통계: 교환 없이 처리한 수
+} NodeCache;
 
 //// 스레드 공유 자원
-Node pool[MAX_PLANE_COUNT]; // malloc의 연산 부하 해결
-Node *freed_head = pool;    // 해제된 리스트의 헤드(가용 가능한 청크)
-// pthread_mutex_t poolMutex = PTHREAD_MUTEX_INITIALIZER;
+Node *pool;                 // malloc의 연산 부하 해결 (mmap 예약 영역, MAX_PLANE_COUNT개)
+Magazine mags[MAG_COUNT];   // 매거진 (pool 노드를 MAG_SIZE개씩 나눠 담음)
+Depot depot;                // 전역 free list (매거진 단위, 전역 lock 대신)
+_Thread_local NodeCache t_cache; // 스레드별 캐시 (alloc/free fast path는 lock 없음)
 
-Queue landingQ[LANDING_Q_COUNT]; // 착륙 큐
+QueueShard landingQ[LANDING_Q_COUNT]; // 착륙 큐 (worker별 샤드)
 Queue takeoffQ[TAKEOFF_Q_COUNT]; // 이륙 큐
 EmergencyStack emergS;
+WorkerPool workers;
 ////
 
 //@ 매 시간 단위마다 집계하기 위한 변수
@@ -82,27 +204,603 @@ int g_total_crashed_plane_count = 0;   //* 사고 당한 모든 비행기의 수
 
 int g_total_landed_count = 0;
 
-// next를 다음 주소와 연결해주는 작업 (리스트의 장점: 삭제 연산)
-void init_pool(void) {
+//// 출력 (로그 레벨 + 사용자 공간 버퍼)
+// printf(unbuffered) 대신 큰 버퍼에 직접 포맷 후 가득 차면 write 1번 >> 시스템 콜 수 감소
+// LOG_LEVEL보다 높은 레벨의 출력 코드는 전처리 단계에서 제거됨
+// LOG_ASYNC: main은 고정 크기 레코드만 링 버퍼에 넣고, 포맷/write는 writer 스레드가 수행
+// >> log_buf는 writer 소유 (writer 종료 후에만 main이 log_printf로 사용)
+char log_buf[LOG_BUF_SIZE];
+size_t log_len = 0;
+
+// 버퍼 비우기 (stdout에 write)
+void log_flush_buf(void) {
+    size_t off = 0;
+    while (off < log_len) {
+        ssize_t n = write(STDOUT_FILENO, log_buf + off, log_len - off);
+        if (n <= 0)
+            break; // 출력 실패: 버리고 계속 진행
+        off += n;
+    }
+    log_len = 0;
+}
+
+// n byte 자리 확보 (부족하면 flush)
+char *log_reserve(size_t n) {
+    if (log_len + n > LOG_BUF_SIZE)
+        log_flush_buf();
+    return log_buf + log_len;
+}
+
+// 문자열 추가
+void log_str(const char *str) {
+    size_t n = strlen(str);
+    memcpy(log_reserve(n), str, n);
+    log_len += n;
+}
+
+// 정수 추가 (snprintf 대신 뒤에서부터 자리수 채움)
+void log_int(long v) {
+    char tmp[24];
+    int i = sizeof(tmp);
+    unsigned long u = (v < 0) ? -(unsigned long)v : (unsigned long)v;
+    do {
+        tmp[--i] = '0' + u % 10;
+        u /= 10;
+    } while (u != 0);
+    if (v < 0)
+        tmp[--i] = '-';
+
+    size_t n = sizeof(tmp) - i;
+    memcpy(log_reserve(n), tmp + i, n);
+    log_len += n;
+}
+
+// 빈도 낮은 출력용 (실수 포맷 등)
+void log_printf(const char *fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(log_reserve(LOG_LINE_MAX), LOG_LINE_MAX, fmt, ap);
+    va_end(ap);
+    if (n > 0)
+        log_len += (n < LOG_LINE_MAX) ? n : LOG_LINE_MAX - 1;
+}
+
+//// 이벤트 레코드 (포맷 전 원본 값만 보관)
+typedef enum LogKind {
+    LOG_REC_TICK,      // v[0]: tick
+    LOG_REC_MSG,       // str: 고정 문자열
+    LOG_REC_KV,        // str: prefix, v[0]: 값
+    LOG_REC_EMERGENCY, // v: idx, rw, fuel, type
+    LOG_REC_CRASHED,   // v: idx, fuel
+    LOG_REC_LANDING,   // v: idx, rw, fuel, type
+    LOG_REC_TAKEOFF,   // v: idx, rw, type
+    LOG_REC_RUNWAY,    // v: rw_used[RUNWAY_COUNT]
+    LOG_REC_COUNT      // v: landed, takeoff, total
+} LogKind;
+
+#define LOG_REC_ARGS (RUNWAY_COUNT > 4 ? RUNWAY_COUNT : 4)
+
+typedef struct LogRec {
+    int kind;
+    const char *str; // 문자열 리터럴만 (수명 = 프로그램 전체)
+    long v[LOG_REC_ARGS];
+} LogRec;
+
+// 레코드 > 텍스트 (형식은 기존 printf와 동일)
+void log_format(const LogRec *r) {
+    switch (r->kind) {
+    case LOG_REC_TICK:
+        log_int(r->v[0]);
+        log_str("---------------------One loop start------------------------\n");
+        break;
+    case LOG_REC_MSG:
+        log_str(r->str);
+        break;
+    case LOG_REC_KV:
+        log_str(r->str);
+        log_int(r->v[0]);
+        log_str("\n");
+        break;
+    case LOG_REC_EMERGENCY:
+    case LOG_REC_LANDING:
+        log_str(r->kind == LOG_REC_EMERGENCY ? "[!] [EMERGENCY] ID: " : "[*] [LANDING] ID: ");
+        log_int(r->v[0]);
+        log_str(", RW: ");
+        log_int(r->v[1]);
+        log_str(", Fuel: ");
+        log_int(r->v[2]);
+        log_str(", Type: ");
+        log_int(r->v[3]);
+        log_str("\n");
+        break;
+    case LOG_REC_CRASHED:
+        log_str("[X] [CRASHED] ID: ");
+        log_int(r->v[0]);
+        log_str(", Fuel: ");
+        log_int(r->v[1]);
+        log_str("\n");
+        break;
+    case LOG_REC_TAKEOFF:
+        log_str("[*] [TAKEOFF] ID: ");
+        log_int(r->v[0]);
+        log_str(", RW: ");
+        log_int(r->v[1]);
+        log_str(", Type: ");
+        log_int(r->v[2]);
+        log_str("\n");
+        break;
+    case LOG_REC_RUNWAY:
+        log_str("[+] [Runway Status] [");
+        for (int i = 0; i < RUNWAY_COUNT; i++) {
+            log_str(" ");
+            log_int(r->v[i]);
+            if (i != RUNWAY_COUNT - 1)
+                log_str(", ");
+        }
+        log_str(" ]\n");
+        break;
+    case LOG_REC_COUNT:
+        log_str("\n[&] landed: ");
+        log_int(r->v[0]);
+        log_str(", takeoff: ");
+        log_int(r->v[1]);
+        log_str(", total: ");
+        log_int(r->v[2]);
+        log_str("\n\n");
+        break;
+    }
+}
+
+#if LOG_ASYNC
+//// SPSC 링 버퍼 (producer: main, consumer: writer 스레드)
+// head/tail은 단조 증가, 인덱스는 & (LOG_RING_SIZE - 1)
+// 서로의 인덱스는 캐시해 두고 부족할 때만 다시 읽음 >> 캐시 라인 왕복 최소화
+typedef struct LogRing {
+    _Alignas(CACHE_LINE_SIZE) _Atomic size_t tail; // main만 씀
+    size_t head_cache;                             // main이 마지막으로 본 head
+    long stall_count;                              // LOG_BP_BLOCK: 가득 차서 기다린 횟수
+    long drop_count;                               // LOG_BP_COUNT: 버린 레코드 수
+    _Alignas(CACHE_LINE_SIZE) _Atomic size_t head; // writer만 씀
+    size_t tail_cache;                             // writer가 마지막으로 본 tail
+    _Alignas(CACHE_LINE_SIZE) atomic_int done;     // main > writer 종료 요청
+    pthread_t tid;
+    LogRec recs[LOG_RING_SIZE];
+} LogRing;
+
+LogRing log_ring;
+
+// writer: 쌓인 레코드를 한꺼번에 포맷, 비어 있으면 버퍼를 내보내고 잠깐 쉼
+void *go_log_writer(void *arg) {
+    (void)arg;
+    LogRing *r = &log_ring;
+    size_t head = atomic_load_explicit(&r->head, memory_order_relaxed);
+    for (;;) {
+        if (head == r->tail_cache) {
+            r->tail_cache = atomic_load_explicit(&r->tail, memory_order_acquire);
+            if (head == r->tail_cache) {
+                // done 확인 후 tail을 한 번 더 읽어야 마지막 레코드를 놓치지 않음
+                if (atomic_load_explicit(&r->done, memory_order_acquire)) {
+                    r->tail_cache = atomic_load_explicit(&r->tail, memory_order_acquire);
+                    if (head == r->tail_cache)
+                        break;
+                    continue;
+                }
+                log_flush_buf(); // 한가할 때 I/O
+                struct timespec ts = {0, LOG_WRITER_IDLE_NS};
+                nanosleep(&ts, NULL);
+                continue;
+            }
+        }
+        while (head != r->tail_cache) {
+            log_format(&r->recs[head & (LOG_RING_SIZE - 1)]);
+            head++;
+        }
+        atomic_store_explicit(&r->head, head, memory_order_release); // 자리 반환은 묶어서 1번
+    }
+    log_flush_buf();
+    return NULL;
+}
+
+// main: 레코드 1개 넣기 (가득 차면 LOG_BACKPRESSURE 정책)
+void log_emit(const LogRec *rec) {
+    LogRing *r = &log_ring;
+    size_t tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    if (tail - r->head_cache == LOG_RING_SIZE) {
+        r->head_cache = atomic_load_explicit(&r->head, memory_order_acquire);
+        if (tail - r->head_cache == LOG_RING_SIZE) {
+#if LOG_BACKPRESSURE == LOG_BP_BLOCK
+            r->stall_count++;
+            do {
+                sched_yield();
+                r->head_cache = atomic_load_explicit(&r->head, memory_order_acquire);
+            } while (tail - r->head_cache == LOG_RING_SIZE);
+#elif LOG_BACKPRESSURE == LOG_BP_COUNT
+            r->drop_count++;
+            return;
+#else
+            return; // LOG_BP_DROP
+#endif
+        }
+    }
+    r->recs[tail & (LOG_RING_SIZE - 1)] = *rec;
+    atomic_store_explicit(&r->tail, tail + 1, memory_order_release);
+}
+
+int log_writer_start(void) {
+    atomic_init(&log_ring.tail, 0);
+    atomic_init(&log_ring.head, 0);
+    atomic_init(&log_ring.done, 0);
+    log_ring.head_cache = 0;
+    log_ring.tail_cache = 0;
+    log_ring.stall_count = 0;
+    log_ring.drop_count = 0;
+    if (pthread_create(&log_ring.tid, NULL, go_log_writer, NULL) != 0) {
+        printf("pthread_create failed.\n");
+        return -1;
+    }
+    return 0;
+}
+
+// 남은 레코드를 모두 쓰고 writer 종료 (이후 log_buf는 main이 사용)
+void log_writer_stop(void) {
+    atomic_store_explicit(&log_ring.done, 1, memory_order_release);
+    pthread_join(log_ring.tid, NULL);
+}
+#else
+void log_emit(const LogRec *rec) {
+    log_format(rec);
+}
+
+int log_writer_start(void) {
+    return 0;
+}
+
+void log_writer_stop(void) {
+    log_flush_buf();
+}
+#endif
+
+// main 쪽 기록 함수 (레코드만 만들어 넘김)
+void log_tick(int tick) {
+    LogRec r = {.kind = LOG_REC_TICK, .v = {tick}};
+    log_emit(&r);
+}
+
+void log_msg(const char *str) {
+    LogRec r = {.kind = LOG_REC_MSG, .str = str};
+    log_emit(&r);
+}
+
+// "prefix" + 정수 + "\n" (tick 요약 한 줄)
+void log_kv(const char *prefix, long v) {
+    LogRec r = {.kind = LOG_REC_KV, .str = prefix, .v = {v}};
+    log_emit(&r);
+}
+
+void log_emergency(Plane *p, int rw) {
+    LogRec r = {.kind = LOG_REC_EMERGENCY, .v = {p->idx, rw, p->fuel, p->type}};
+    log_emit(&r);
+}
+
+void log_crashed(Plane *p) {
+    LogRec r = {.kind = LOG_REC_CRASHED, .v = {p->idx, p->fuel}};
+    log_emit(&r);
+}
+
+void log_landing(Plane *p, int rw) {
+    LogRec r = {.kind = LOG_REC_LANDING, .v = {p->idx, rw, p->fuel, p->type}};
+    log_emit(&r);
+}
+
+void log_takeoff(Plane *p, int rw) {
+    LogRec r = {.kind = LOG_REC_TAKEOFF, .v = {p->idx, rw, p->type}};
+    log_emit(&r);
+}
+
+// 활주로 점유 상태 한 줄
+void log_runway_status(int *rw_used) {
+    LogRec r = {.kind = LOG_REC_RUNWAY};
+    for (int i = 0; i < RUNWAY_COUNT; i++)
+        r.v[i] = rw_used[i];
+    log_emit(&r);
+}
+
+// tick 마무리 집계 한 줄
+void log_tick_count(int landed, int takeoff, int total) {
+    LogRec r = {.kind = LOG_REC_COUNT, .v = {landed, takeoff, total}};
+    log_emit(&r);
+}
+
+// 레벨별 출력 (해당 레벨이 꺼져 있으면 인자 계산까지 제거)
+#if LOG_LEVEL >= LOG_SUMMARY
+#define LOG_SUMMARY_DO(stmt) stmt
+#else
+#define LOG_SUMMARY_DO(stmt) ((void)0)
+#endif
+#if LOG_LEVEL >= LOG_TICK
+#define LOG_TICK_DO(stmt) stmt
+#else
+#define LOG_TICK_DO(stmt) ((void)0)
+#endif
+#if LOG_LEVEL >= LOG_EVENT
+#define LOG_EVENT_DO(stmt) stmt
+#else
+#define LOG_EVENT_DO(stmt) ((void)0)
+#endif
+
+#if TRACE_ENABLE
+//// 바이너리 트레이스 (형식: SWpj3_trace.h)
+// 종류별 블록 버퍼에 열 단위로 모았다가 가득 차면 블록 1개를 writev 1번으로 기록
+// >> 후처리에서 텍스트 로그를 정규식으로 파싱할 필요 없음 (SWpj3_trace_decode.c)
+typedef struct TraceBuf {
+    int count;
+    int32_t col[TRACE_MAX_COLS][TRACE_BLOCK_EVENTS];
+} TraceBuf;
+
+TraceBuf trace_bufs[TRACE_TYPE_COUNT];
+TraceHeader trace_hdr;
+int trace_fd = -1;
+
+// iov 전체를 기록 (부분 기록이면 남은 부분부터 다시)
+int trace_writev_all(struct iovec *iov, int cnt) {
+    while (cnt > 0) {
+        ssize_t n = writev(trace_fd, iov, cnt);
+        if (n < 0)
+            return -1;
+        while (cnt > 0 && (size_t)n >= iov->iov_len) {
+            n -= iov->iov_len;
+            iov++;
+            cnt--;
+        }
+        if (cnt > 0) {
+            iov->iov_base = (char *)iov->iov_base + n;
+            iov->iov_len -= n;
+        }
+    }
+    return 0;
+}
+
+int trace_open(uint64_t seed, uint32_t replication) {
+    trace_fd = open(TRACE_PATH, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (trace_fd < 0) {
+        fprintf(stderr, "trace open failed: %s\n", TRACE_PATH); // stdout은 출력 스레드 소유
+        return -1;
+    }
+    memset(&trace_hdr, 0, sizeof(trace_hdr));
+    memcpy(trace_hdr.magic, TRACE_MAGIC, sizeof(trace_hdr.magic));
+    trace_hdr.version = TRACE_VERSION;
+    trace_hdr.header_size = sizeof(TraceHeader);
+    trace_hdr.landing_q_count = LANDING_Q_COUNT;
+    trace_hdr.takeoff_q_count = TAKEOFF_Q_COUNT;
+    trace_hdr.runway_count = RUNWAY_COUNT;
+    trace_hdr.takeoff_only = TAKEOFF_ONLY;
+    trace_hdr.simulation_done = SIMULATION_DONE;
+    trace_hdr.block_events = TRACE_BLOCK_EVENTS;
+    trace_hdr.seed = seed;
+    trace_hdr.replication = replication;
+
+    // 이벤트 수는 아직 0 (trace_close에서 다시 기록)
+    struct iovec iov = {&trace_hdr, sizeof(trace_hdr)};
+    if (trace_writev_all(&iov, 1)) {
+        fprintf(stderr, "trace write failed: %s\n", TRACE_PATH);
+        close(trace_fd);
+        trace_fd = -1;
+        return -1;
+    }
+    return 0;
+}
+
+// 해당 종류의 버퍼를 블록 1개로 기록
+void trace_flush_block(int type) {
+    TraceBuf *t = &trace_bufs[type];
+    if (t->count == 0)
+        return;
+
+    TraceBlock b = {type, t->count, trace_cols[type], TRACE_COL_STRIDE(t->count)};
+    struct iovec iov[1 + TRACE_MAX_COLS];
+    iov[0].iov_base = &b;
+    iov[0].iov_len = sizeof(b);
+    for (uint32_t c = 0; c < b.cols; c++) {
+        for (uint32_t k = b.count; k < b.stride; k++)
+            t->col[c][k] = 0; // 정렬용 패딩
+        iov[1 + c].iov_base = t->col[c];
+        iov[1 + c].iov_len = b.stride * sizeof(int32_t);
+    }
+    if (trace_writev_all(iov, 1 + b.cols)) {
+        // 블록 중간이 잘린 파일은 디코딩 불가 >> 트레이스만 끄고 시뮬레이션은 계속 진행
+        fprintf(stderr, "trace write failed: %s (tracing stopped)\n", TRACE_PATH);
+        close(trace_fd);
+        trace_fd = -1;
+        t->count = 0;
+        return;
+    }
+
+    trace_hdr.event_count[type] += t->count;
+    trace_hdr.block_count++;
+    t->count = 0;
+}
+
+// 이벤트 1개 추가 (열마다 같은 위치에 기록)
+void trace_add(int type, const int32_t *v) {
+    if (trace_fd < 0) // 기록 실패로 중단됨
+        return;
+    TraceBuf *t = &trace_bufs[type];
+    for (int c = 0; c < trace_cols[type]; c++)
+        t->col[c][t->count] = v[c];
+    if (++t->count == TRACE_BLOCK_EVENTS)
+        trace_flush_block(type);
+}
+
+// 남은 블록 기록 + 헤더의 이벤트 수 갱신
+void trace_close(void) {
+    for (int type = 0; type < TRACE_TYPE_COUNT && trace_fd >= 0; type++)
+        trace_flush_block(type);
+    if (trace_fd < 0) // 이미 중단됨 (헤더의 이벤트 수는 0으로 남음)
+        return;
+    if (pwrite(trace_fd, &trace_hdr, sizeof(trace_hdr), 0) != sizeof(trace_hdr))
+        fprintf(stderr, "trace header write failed: %s\n", TRACE_PATH);
+    close(trace_fd);
+    trace_fd = -1;
+}
+
+void trace_tick(int tick, int total_planes, int landing_qsize, int takeoff_qsize) {
+    int32_t v[TT_COLS] = {tick, total_planes, landing_qsize, takeoff_qsize};
+    trace_add(TRACE_TICK, v);
+}
+
+void trace_landing(int tick, Plane *p, int queue, int rw) {
+    int32_t v[TL_COLS] = {tick, p->idx, queue, rw, p->fuel, tick - p->entryTime};
+    trace_add(TRACE_LANDING, v);
+}
+
+void trace_takeoff(int tick, Plane *p, int queue, int rw) {
+    int32_t v[TO_COLS] = {tick, p->idx, queue, rw, tick - p->entryTime};
+    trace_add(TRACE_TAKEOFF, v);
+}
+
+void trace_emergency(int tick, Plane *p, int rw) {
+    int32_t v[TE_COLS] = {tick, p->idx, rw, p->fuel, tick - p->entryTime};
+    trace_add(TRACE_EMERGENCY, v);
+}
+
+void trace_crashed(int tick, Plane *p) {
+    int32_t v[TC_COLS] = {tick, p->idx, p->fuel, tick - p->entryTime};
+    trace_add(TRACE_CRASHED, v);
+}
+
+#define TRACE_DO(stmt) stmt
+#else
+#define TRACE_DO(stmt) ((void)0)
+#endif
+
+// 풀 초기화: 주소 공간만 예약 (노드 연결 X)
+// 노드는 depot에 꽉 찬 매거진이 없을 때 MAG_SIZE개씩 잘라서 연결 (depot_take_full)
+// >> 시작 시 전체를 훑지 않고, 페이지는 실제로 쓴 노드만큼만 커밋됨 (MAX_PLANE_COUNT를 크게 잡아도 됨)
+int init_pool(void) {
+    pool = mmap(NULL, (size_t)MAX_PLANE_COUNT * sizeof(Node), PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (pool == MAP_FAILED)
+        return -1;
+
+    depot.full = NULL;
+    depot.empty = NULL;
+    depot.carved = 0;
+    depot.mag_used = 0;
+    depot.exchange_count = 0;
+    depot.fast_count = 0;
+    pthread_mutex_init(&depot.lock, NULL);
+    return 0;
+}
+
+// depot 리스트 pop (lock 안에서 호출)
+Magazine *depot_pop(Magazine **list) {
+    Magazine *mag = *list;
+    if (mag != NULL)
+        *list = mag->next;
+    return mag;
+}
+
+// depot 리스트 push (lock 안에서 호출)
+void depot_push(Magazine **list, Magazine *mag) {
+    mag->next = *list;
+    *list = mag;
+}
+
+// 빈 매거진 (lock 안에서 호출, 창고에 없으면 아직 안 쓴 구조체)
+// >> 노드가 든 매거진 <= MAG_FULL_COUNT + 스레드마다 2개 이므로 MAG_COUNT 안에서 항상 있음
+Magazine *depot_take_empty(void) {
+    Magazine *mag = depot_pop(&depot.empty);
+    if (mag == NULL) {
+        mag = &mags[depot.mag_used++];
+        mag->top = NULL;
+        mag->count = 0;
+    }
+    return mag;
+}
+
+// 꽉 찬 매거진 (lock 안에서 호출, 창고에 없으면 안 쓴 pool 영역에서 MAG_SIZE개 잘라서 채움)
+// 반환값 NULL: 풀 전체를 다 씀
+Magazine *depot_take_full(void) {
+    Magazine *mag = depot_pop(&depot.full);
+    if (mag != NULL || depot.carved == MAX_PLANE_COUNT)
+        return mag;
+
+    int first = depot.carved;
+    int count = MAX_PLANE_COUNT - first;
+    if (count > MAG_SIZE)
+        count = MAG_SIZE;
+
     // 마지막 idx직전까지 연결, next는 포인터: 주소를 연결
-    for (int i = 0; i < MAX_PLANE_COUNT - 1; i++) {
-        pool[i].next = &pool[i + 1];
+    for (int i = 0; i < count - 1; i++) {
+        pool[first + i].next = &pool[first + i + 1];
     }
     // 마지막 idx는 next가 NULL이어야 함.
-    pool[MAX_PLANE_COUNT - 1].next = NULL;
+    pool[first + count - 1].next = NULL;
+    depot.carved += count;
+
+    mag = depot_take_empty();
+    mag->top = &pool[first];
+    mag->count = count;
+    return mag;
+}
+
+// 현재 스레드의 캐시 (처음 쓸 때 빈 매거진 2개를 받아옴)
+NodeCache *get_node_cache(void) {
+    NodeCache *c = &t_cache;
+    if (c->loaded == NULL) {
+        pthread_mutex_lock(&depot.lock);
+        c->loaded = depot_take_empty();
+        c->previous = depot_take_empty();
+        pthread_mutex_unlock(&depot.lock);
+    }
+    return c;
+}
+
+// 스레드 종료 전 캐시 통계를 depot에 합산 (매거진은 그대로 둠)
+void flush_node_cache_stats(void) {
+    pthread_mutex_lock(&depot.lock);
+    depot.fast_count += t_cache.fast_count;
+    t_cache.fast_count = 0;
+    pthread_mutex_unlock(&depot.lock);
 }
 
 // LIFO 구조 노드 반환
+// 반환값 NULL: 풀 전체가 비었음 (FULL MEMORY) >> 호출자가 확인하고 보고해야 함
+// worker 스레드에서도 불리므로 여기서는 출력하지 않음 (출력은 main의 log 계층만 사용)
 Node *alloc_node(void) {
-    // 가용 가능한 청크가 없는 경우(다 씀)
-    if (freed_head == NULL) {
-        printf("freed_head is NULL (FULL MEMORY)\n");
-        return NULL;
+    NodeCache *c = get_node_cache();
+
+    if (c->loaded->count == 0) {
+        // 직전 매거진에 남아 있으면 교체만
+        if (c->previous->count > 0) {
+            Magazine *tmp = c->loaded;
+            c->loaded = c->previous;
+            c->previous = tmp;
+        }
+        // 둘 다 비었으면 depot에서 꽉 찬 매거진과 교환
+        else {
+            pthread_mutex_lock(&depot.lock);
+            Magazine *full = depot_take_full();
+            if (full != NULL) {
+                depot_push(&depot.empty, c->previous);
+                c->previous = c->loaded;
+                c->loaded = full;
+                depot.exchange_count++;
+            }
+            pthread_mutex_unlock(&depot.lock);
+
+            // 가용 가능한 청크가 없는 경우(다 씀)
+            if (full == NULL)
+                return NULL;
+        }
     }
+    else
+        c->fast_count++;
 
-    // 하나씩 가져가며 pool은 줄어듦.
-    Node *newNode = freed_head;
-    freed_head = freed_head->next;
+    // 하나씩 가져가며 매거진은 줄어듦.
+    Node *newNode = c->loaded->top;
+    c->loaded->top = newNode->next;
+    c->loaded->count--;
 
     // 배열에서 떼어내 연결리스트로 사용할 것이기 때문에 기존 연결을 끊어줘야 함.
     newNode->next = NULL;
@@ -111,9 +809,93 @@ Node *alloc_node(void) {
 
 // LIFO 구조 노드 해제 및 재사용을 위한 연결
 void free_node(Node *temp) {
+    NodeCache *c = get_node_cache();
+
+    if (c->loaded->count == MAG_SIZE) {
+        // 직전 매거진에 자리가 있으면 교체만
+        if (c->previous->count < MAG_SIZE) {
+            Magazine *tmp = c->loaded;
+            c->loaded = c->previous;
+            c->previous = tmp;
+        }
+        // 둘 다 꽉 찼으면 depot에 꽉 찬 매거진을 넘기고 빈 매거진을 받음
+        else {
+            pthread_mutex_lock(&depot.lock);
+            depot_push(&depot.full, c->previous);
+            c->previous = c->loaded;
+            c->loaded = depot_take_empty(); // MAG_COUNT 여유로 항상 있음
+            depot.exchange_count++;
+            pthread_mutex_unlock(&depot.lock);
+        }
+    }
+    else
+        c->fast_count++;
+
     // 해제된 청크를 다시 사용 (LIFO)
-    temp->next = freed_head;
-    freed_head = temp;
+    temp->next = c->loaded->top;
+    c->loaded->top = temp;
+    c->loaded->count++;
+}
+
+// 연결된 리스트(head ~ tail, count개)를 한 번에 반환
+// 현재 매거진에 자리가 있으면 splice (포인터 2번 쓰기), 아니면 1개씩 (매거진 교환 포함)
+void free_nodes(Node *head, Node *tail, int count) {
+    if (head == NULL)
+        return;
+
+    NodeCache *c = get_node_cache();
+    if (c->loaded->count + count <= MAG_SIZE) {
+        tail->next = c->loaded->top;
+        c->loaded->top = head;
+        c->loaded->count += count;
+        c->fast_count += count;
+        return;
+    }
+
+    while (head != NULL) {
+        Node *nextNode = head->next; // 반환 전 미리 저장
+        free_node(head);
+        head = nextNode;
+    }
+}
+
+// 노드 최대 k개를 연결된 chain으로 한 번에 반환
+// 현재 매거진에 k개 이상 있으면 k번째에서 끊기만 함, 아니면 1개씩 (매거진 교환 포함)
+// 반환값: 실제 받은 수, *head ~ *tail: 받은 chain (tail->next == NULL, 0개면 둘 다 NULL)
+// >> 풀이 중간에 비면 받은 만큼만 돌려줌 (반환값 < k): 호출자가 부족분을 확인하고 보고해야 함
+int alloc_nodes(int k, Node **head, Node **tail) {
+    *head = *tail = NULL;
+    if (k <= 0)
+        return 0;
+
+    NodeCache *c = get_node_cache();
+    if (c->loaded->count >= k) {
+        Node *first = c->loaded->top;
+        Node *last = first;
+        for (int i = 1; i < k; i++)
+            last = last->next;
+
+        c->loaded->top = last->next;
+        c->loaded->count -= k;
+        c->fast_count += k;
+        last->next = NULL; // chain 끝 표시
+        *head = first;
+        *tail = last;
+        return k;
+    }
+
+    int n = 0;
+    for (; n < k; n++) {
+        Node *newNode = alloc_node();
+        if (newNode == NULL)
+            break; // 풀 소진: 받은 것까지만
+        if (*head == NULL)
+            *head = newNode;
+        else
+            (*tail)->next = newNode;
+        *tail = newNode;
+    }
+    return n;
 }
 
 // FIFO 구조 큐 초기화
@@ -153,6 +935,43 @@ Node *dequeue(Queue *queue) {
     return node;
 }
 
+// FIFO 구조 큐에 chain(head ~ tail, count개) 통째로 삽입 O(1)
+void enqueue_chain(Queue *queue, Node *head, Node *tail, int count) {
+    if (head == NULL)
+        return;
+    tail->next = NULL; // 기존 연결이 있을 수 있으니 해제
+    if (queue->tail == NULL)
+        queue->head = head; // 빈 큐: head 조정
+    else
+        queue->tail->next = head;
+    queue->tail = tail;
+    queue->size += count;
+}
+
+// FIFO 구조 큐 앞에서 최대 k개를 chain으로 삭제
+// 반환값: 실제 꺼낸 수, *head ~ *tail: 꺼낸 chain (tail->next == NULL)
+int dequeue_n(Queue *queue, int k, Node **head, Node **tail) {
+    if (queue->head == NULL || k <= 0) {
+        *head = *tail = NULL;
+        return 0; // head에 아무것도 없는 경우
+    }
+
+    Node *last = queue->head;
+    int n = 1;
+    for (; n < k && last->next != NULL; n++)
+        last = last->next;
+
+    *head = queue->head;
+    *tail = last;
+    queue->head = last->next;
+    if (queue->head == NULL)
+        queue->tail = NULL; // tail 조정
+    queue->size -= n;
+
+    last->next = NULL; // chain 끝 표시
+    return n;
+}
+
 // 가장 짧은 큐의 인덱스 반환 (비행기 생성 시 사용)
 int get_shortest_queue_idx(Queue *q_addr, int q_size) {
     int min_q_idx = -1;
@@ -166,78 +985,391 @@ int get_shortest_queue_idx(Queue *q_addr, int q_size) {
     return min_q_idx;
 }
 
+// 가장 짧은 착륙 큐 샤드의 인덱스 반환 (샤드는 캐시 라인 단위라 Queue 배열로 넘길 수 없음)
+int get_shortest_shard_idx(QueueShard *s_addr, int s_size) {
+    int min_q_idx = -1;
+    int min_q_size = 1000000000;
+    for (int i = 0; i < s_size; i++) {
+        if (s_addr[i].q.size < min_q_size) {
+            min_q_size = s_addr[i].q.size;
+            min_q_idx = i;
+        }
+    }
+    return min_q_idx;
+}
+
+//// 도착 / 연료 모델 (ARRIVAL_MODEL, FUEL_MODEL)
+// 도착 수는 tick마다 분포에서 바로 1번 샘플링 (비행기 수만큼 난수를 뽑지 않음)
+// >> 평균이 수백만이어도 tick당 비용은 상수
+// RNG_ARRIVAL 스트림의 sub: 0 = 균등 모델(이/착륙 공용), 1 = 착륙, 2 = 이륙, 3 = MMPP 상태 전이
+enum { ARR_SUB_UNIFORM, ARR_SUB_LANDING, ARR_SUB_TAKEOFF, ARR_SUB_STATE };
+
+int g_mmpp_burst = 0;         // MMPP 현재 상태 (0: 평상, 1: 폭주)
+long g_mmpp_burst_ticks = 0;  // 통계: 폭주 상태였던 tick 수
+long g_arrival_clamped = 0;   // 통계: GEN_BATCH_MAX를 넘어 잘린 tick 수
+
+// (0, 1) 실수 (양 끝 제외: log, pow에 그대로 사용)
+double rng_uniform(Rng *r) {
+    return (rng_next(r) + 0.5) * (1.0 / 4294967296.0);
+}
+
+// 평균 lambda 포아송 (작으면 곱셈법, 크면 PTRS 변환 기각법: 평균과 상관없이 기대 반복 상수)
+int sample_poisson(Rng *r, double lambda) {
+    if (lambda <= 0.0)
+        return 0;
+    if (lambda < 30.0) {
+        double limit = exp(-lambda);
+        double prod = rng_uniform(r);
+        int k = 0;
+        while (prod > limit) {
+            prod *= rng_uniform(r);
+            k++;
+        }
+        return k;
+    }
+
+    // Hörmann (1993) PTRS
+    double slam = sqrt(lambda);
+    double loglam = log(lambda);
+    double b = 0.931 + 2.53 * slam;
+    double a = -0.059 + 0.02483 * b;
+    double invalpha = 1.1239 + 1.1328 / (b - 3.4);
+    double vr = 0.9277 - 3.6224 / (b - 2);
+    while (1) {
+        double u = rng_uniform(r) - 0.5;
+        double v = rng_uniform(r);
+        double us = 0.5 - fabs(u);
+        double k = floor((2 * a / us + b) * u + lambda + 0.43);
+        if (us >= 0.07 && v <= vr)
+            return (int)k;
+        if (k < 0 || (us < 0.013 && v > us))
+            continue;
+        if (log(v) + log(invalpha) - log(a / (us * us) + b) <= -lambda + k * loglam - lgamma(k + 1))
+            return (int)k;
+    }
+}
+
+// 이 tick의 평균 도착 수 (이/착륙 각각)
+double arrival_rate(int tick) {
+#if ARRIVAL_MODEL == ARRIVAL_MMPP
+    // 상태 전이는 tick 순서대로 (이전 상태에 의존)
+    Rng state = rng_stream(RNG_ARRIVAL, tick, ARR_SUB_STATE);
+    double u = rng_uniform(&state);
+    if (g_mmpp_burst)
+        g_mmpp_burst = (u >= MMPP_P_LEAVE);
+    else
+        g_mmpp_burst = (u < MMPP_P_ENTER);
+    g_mmpp_burst_ticks += g_mmpp_burst;
+    return g_mmpp_burst ? MMPP_BURST_RATE : ARRIVAL_RATE;
+#elif ARRIVAL_MODEL == ARRIVAL_DIURNAL
+    double rate = ARRIVAL_RATE * (1.0 + DIURNAL_AMPLITUDE * sin(2.0 * M_PI * tick / DIURNAL_PERIOD));
+    return rate > 0.0 ? rate : 0.0;
+#else
+    (void)tick;
+    return ARRIVAL_RATE;
+#endif
+}
+
+// GEN_BATCH_MAX 넘으면 자름 (생성 배열 크기)
+int clamp_batch(int n) {
+    if (n > GEN_BATCH_MAX) {
+        g_arrival_clamped++;
+        return GEN_BATCH_MAX;
+    }
+    return n;
+}
+
+// 이 tick의 도착 수
+void sample_arrivals(int tick, int *land, int *take) {
+#if ARRIVAL_MODEL == ARRIVAL_UNIFORM
+    Rng arrival = rng_stream(RNG_ARRIVAL, tick, ARR_SUB_UNIFORM);
+    *land = rng_range(rng_next(&arrival), ARRIVAL_MAX); // 0 ~ ARRIVAL_MAX-1
+    *take = rng_range(rng_next(&arrival), ARRIVAL_MAX);
+#else
+    double rate = arrival_rate(tick);
+    Rng land_r = rng_stream(RNG_ARRIVAL, tick, ARR_SUB_LANDING);
+    Rng take_r = rng_stream(RNG_ARRIVAL, tick, ARR_SUB_TAKEOFF);
+    *land = clamp_batch(sample_poisson(&land_r, rate));
+    *take = clamp_batch(sample_poisson(&take_r, rate));
+#endif
+}
+
+// 착륙 비행기 연료 (r: 비행기마다 받은 난수 블록의 한 칸)
+int sample_fuel(uint32_t r) {
+#if FUEL_MODEL == FUEL_PARETO
+    // 파레토: 대부분 FUEL_PARETO_MIN 근처, 가끔 매우 큼 (P(X > x) = (min/x)^alpha)
+    double u = (r + 0.5) * (1.0 / 4294967296.0);
+    double fuel = FUEL_PARETO_MIN * pow(u, -1.0 / FUEL_PARETO_ALPHA);
+    return fuel < FUEL_CAP ? (int)fuel : FUEL_CAP;
+#else
+    return rng_range(r, 49) + 20; // 20~68
+#endif
+}
+
+const char *arrival_model_name(void) {
+    const char *names[] = {"uniform", "poisson", "mmpp", "diurnal"};
+    return names[ARRIVAL_MODEL];
+}
+
+//// 비행기 생성 (tick 단위 일괄 처리)
+// 1) 도착 수 결정 > 2) 큐별 배분(gen_plan) > 3) 큐마다 속성 일괄 샘플링(배열) + chain 할당/기입/연결
+// 난수는 (tick, tick 내 순번) 으로 바로 계산되므로 큐별 작업을 어느 스레드가 해도 결과 동일
+// >> 생성 수가 GEN_PARALLEL_MIN 이상이면 worker i가 착륙 큐 i (+ 이륙 큐 i, i+LANDING_Q_COUNT..) 담당
+typedef struct Gen_plan {
+    int tick;
+    int land_base;                  // 이번 tick 첫 착륙 id (짝수)
+    int take_base;                  // 이번 tick 첫 이륙 id (홀수)
+    int land_from[LANDING_Q_COUNT]; // 큐별 tick 내 시작 순번
+    int land_count[LANDING_Q_COUNT];
+    int take_from[TAKEOFF_Q_COUNT];
+    int take_count[TAKEOFF_Q_COUNT];
+    int land_short[LANDING_Q_COUNT]; // 큐별 할당 부족분 (큐 담당 스레드만 씀)
+    int take_short[TAKEOFF_Q_COUNT];
+} GenPlan;
+
+GenPlan gen_plan;
+int32_t gen_fuel[GEN_BATCH_MAX]; // 착륙 비행기 속성 (tick 내 순번 idx, 큐마다 겹치지 않는 구간만 씀)
+int32_t gen_consume[GEN_BATCH_MAX];
+_Static_assert(ARRIVAL_MAX - 1 <= GEN_BATCH_MAX, "ARRIVAL_MAX too large for GEN_BATCH_MAX");
+// 이/착륙 최대 생성 수(GEN_BATCH_MAX씩)가 한 tick에 다 들어가고도 대기 중인 비행기 자리가 남아야 함
+// >> 넘치는 도착은 fit_pool이 버리고 집계 (Dropped Planes)
+_Static_assert(MAX_PLANE_COUNT >= 4 * GEN_BATCH_MAX + POOL_CACHE_MAX, "MAX_PLANE_COUNT too small for GEN_BATCH_MAX");
+long g_parallel_gen_count = 0; // 통계: worker로 나눠 생성한 tick 수
+long g_dropped_plane_count = 0; // 통계: 풀 소진(FULL MEMORY)으로 큐에 못 넣은 비행기 수
+
+// total개를 큐 길이가 고르게 되도록 나눔 (짧은 큐부터 같은 높이로 채우기)
+// 남는 것은 idx 순서대로 1개씩 >> 입력이 같으면 배분도 항상 같음
+void split_even(int total, const int *size, int n, int *count) {
+    int min_size = size[0];
+    for (int i = 1; i < n; i++)
+        if (size[i] < min_size)
+            min_size = size[i];
+
+    // 채울 수 있는 최대 높이 level: sum(max(0, level - size)) <= total
+    long lo = min_size, hi = (long)min_size + total;
+    while (lo < hi) {
+        long mid = (lo + hi + 1) / 2;
+        long need = 0;
+        for (int i = 0; i < n; i++)
+            if (size[i] < mid)
+                need += mid - size[i];
+        if (need <= total)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+
+    int left = total;
+    for (int i = 0; i < n; i++) {
+        count[i] = (size[i] < lo) ? (int)(lo - size[i]) : 0;
+        left -= count[i];
+    }
+    for (int i = 0; i < n && left > 0; i++) {
+        if (size[i] <= lo) {
+            count[i]++;
+            left--;
+        }
+    }
+}
+
+// 큐별 배분: 적으면 가장 짧은 큐 하나에 전부, 많으면 고르게
+void plan_queues(int total, const int *size, int n, int *from, int *count) {
+    if (total < GEN_SPREAD_MIN) {
+        int min_q_idx = 0;
+        for (int i = 1; i < n; i++)
+            if (size[i] < size[min_q_idx])
+                min_q_idx = i;
+        for (int i = 0; i < n; i++)
+            count[i] = 0;
+        count[min_q_idx] = total;
+    }
+    else
+        split_even(total, size, n, count);
+
+    // 순번 구간은 큐 idx 순서대로 이어 붙임
+    int acc = 0;
+    for (int i = 0; i < n; i++) {
+        from[i] = acc;
+        acc += count[i];
+    }
+}
+
+// 착륙 비행기 속성 일괄 샘플링 [from, from + count)
+void gen_sample_landing(int tick, int from, int count) {
+    for (int k = from; k < from + count; k++) {
+        uint32_t r[4];
+        rng_block(RNG_LANDING_PLANE, tick, 0, k, r);
+        gen_fuel[k] = sample_fuel(r[0]);         // FUEL_MODEL
+        gen_consume[k] = rng_range(r[1], 3) + 3; // 1~3: 0이 되면 안됨
+    }
+}
+
+// 착륙 큐 1개 몫: 샘플링 > chain 할당 > 기입 > 연결
+void gen_landing_queue(int q_idx) {
+    GenPlan *p = &gen_plan;
+    int from = p->land_from[q_idx];
+    int count = p->land_count[q_idx]; // 0이어도 부족분(0)은 기록
+
+    gen_sample_landing(p->tick, from, count);
+
+    Node *head, *tail;
+    int got = alloc_nodes(count, &head, &tail);
+    p->land_short[q_idx] = count - got; // 풀 소진으로 못 만든 수 (main이 합산해서 보고)
+    int k = from;
+    for (Node *newNode = head; newNode != NULL; newNode = newNode->next, k++) {
+        newNode->plane.idx = p->land_base + 2 * k; // 착륙: 짝수 정수
+        newNode->plane.fuel = gen_fuel[k];
+        newNode->plane.entryTime = p->tick; // 생성 시점(통계)
+        newNode->plane.consume = gen_consume[k];
+        newNode->plane.type = 0; // 착륙: 0
+    }
+    enqueue_chain(&landingQ[q_idx].q, head, tail, got); // 받은 만큼만 착륙 큐 삽입
+}
+
+// 이륙 큐 1개 몫 (이륙 비행기는 난수 속성 없음)
+void gen_takeoff_queue(int q_idx) {
+    GenPlan *p = &gen_plan;
+    int from = p->take_from[q_idx];
+    int count = p->take_count[q_idx]; // 0이어도 부족분(0)은 기록
+
+    Node *head, *tail;
+    int got = alloc_nodes(count, &head, &tail);
+    p->take_short[q_idx] = count - got;
+    int k = from;
+    for (Node *newNode = head; newNode != NULL; newNode = newNode->next, k++) {
+        newNode->plane.idx = p->take_base + 2 * k; // 이륙: 홀수 정수
+        newNode->plane.entryTime = p->tick;
+        newNode->plane.type = 1; //이륙: 1
+    }
+    enqueue_chain(&takeoffQ[q_idx], head, tail, got); // 받은 만큼만 이륙 큐 삽입
+}
+
+// worker w의 생성 몫 (착륙 큐 w + 이륙 큐 w, w+LANDING_Q_COUNT, ..)
+// 큐는 담당 worker만 건드림, 노드는 worker 자신의 매거진에서 할당 >> lock 없음
+void gen_worker(int w) {
+    gen_landing_queue(w);
+    for (int j = w; j < TAKEOFF_Q_COUNT; j += LANDING_Q_COUNT)
+        gen_takeoff_queue(j);
+}
+
+// 풀 여유만큼만 생성하도록 도착 수를 줄임 (반환값: 줄인 수)
+// 생성은 tick 맨 앞 >> 살아있는 노드는 전부 큐 안 (queued개)
+// 다른 스레드 캐시에 묶인 노드(최대 POOL_CACHE_MAX)를 빼고 남는 만큼이면 어느 스레드가 할당해도 부족하지 않음
+int fit_pool(int queued, int *land, int *take) {
+    long room = (long)MAX_PLANE_COUNT - queued - POOL_CACHE_MAX;
+    int want = *land + *take;
+    if (room < 0)
+        room = 0;
+    if (want <= room)
+        return 0;
+
+    // 이/착륙 비율대로 나눔 (keep_take = ceil(take * room / want) <= take)
+    int keep_land = (int)((long)*land * room / want);
+    int keep_take = (int)room - keep_land;
+    *land = keep_land;
+    *take = keep_take;
+    return want - (int)room;
+}
+
 // 이/착륙 비행기 생성 및 큐 삽입 & 생성 비행기 수 집계
 int generate_planes(int entryTime) {
     static int land_idx = 2; // 착륙: 짝수 정수
     static int take_idx = 1; // 이륙: 홀수 정수
 
-    int land_planes_cnt = rand() % 6; //0~3
-    int take_planes_cnt = rand() % 6;
-
-    g_total_plane_count += (land_planes_cnt + take_planes_cnt); // 생성 비행기 수 집계
+    // 이 tick의 도착 수 (ARRIVAL_MODEL, tick마다 독립 스트림)
+    int land_planes_cnt, take_planes_cnt;
+    sample_arrivals(entryTime, &land_planes_cnt, &take_planes_cnt);
 
-    int landingQ_idx = get_shortest_queue_idx(landingQ, LANDING_Q_COUNT); // 짧은 큐 한 번 구해서 그냥 다 넣기 (비행기 수 적을 때)
-    int takeoffQ_idx = get_shortest_queue_idx(takeoffQ, TAKEOFF_Q_COUNT);
-
-    // 착륙 비행기 정보 기입
-    for (int i = 0; i < land_planes_cnt; i++) {
-        Node *newNode = alloc_node(); // Node 할당
-        newNode->plane.idx = land_idx;
-        newNode->plane.fuel = rand() % 49 + 20;  // 20~68
-        newNode->plane.entryTime = entryTime;    // 생성 시점(통계)
-        newNode->plane.consume = rand() % 3 + 3; // 1~3: 0이 되면 안됨
-        newNode->plane.type = 0;                 // 착륙: 0
+    int land_size[LANDING_Q_COUNT];
+    int take_size[TAKEOFF_Q_COUNT];
+    int queued = 0;
+    for (int i = 0; i < LANDING_Q_COUNT; i++) {
+        land_size[i] = landingQ[i].q.size;
+        queued += land_size[i];
+    }
+    for (int i = 0; i < TAKEOFF_Q_COUNT; i++) {
+        take_size[i] = takeoffQ[i].size;
+        queued += take_size[i];
+    }
 
-        // int landingQ_idx = get_shortest_queue_idx(landingQ, LANDING_Q_COUNT); // 연산 수 증가
-        land_idx += 2;
-        enqueue(&landingQ[landingQ_idx], newNode); // 착륙 큐 삽입
+    // 풀에 안 들어가는 도착은 id를 주기 전에 버림 (id, 생성 수는 실제 만든 비행기만)
+    int dropped = fit_pool(queued, &land_planes_cnt, &take_planes_cnt);
+
+    // 큐별 배분 (id는 순번 순서대로: 실행 방식과 무관)
+    GenPlan *p = &gen_plan;
+    p->tick = entryTime;
+    p->land_base = land_idx;
+    p->take_base = take_idx;
+    plan_queues(land_planes_cnt, land_size, LANDING_Q_COUNT, p->land_from, p->land_count);
+    plan_queues(take_planes_cnt, take_size, TAKEOFF_Q_COUNT, p->take_from, p->take_count);
+    land_idx += 2 * land_planes_cnt;
+    take_idx += 2 * take_planes_cnt;
+
+    if (land_planes_cnt + take_planes_cnt >= GEN_PARALLEL_MIN) {
+        // 상주 worker에게 생성 작업으로 깨움
+        workers.job = WORK_GENERATE;
+        pthread_barrier_wait(&workers.start_barrier);
+        pthread_barrier_wait(&workers.done_barrier);
+        workers.job = WORK_FUEL;
+        g_parallel_gen_count++;
+    }
+    else {
+        for (int w = 0; w < LANDING_Q_COUNT; w++)
+            gen_worker(w);
     }
-    //이륙 비행기 정보 기입
-    for (int i = 0; i < take_planes_cnt; i++) {
-        Node *newNode = alloc_node();
-        newNode->plane.idx = take_idx;
-        newNode->plane.entryTime = entryTime;
-        newNode->plane.type = 1; //이륙: 1
 
-        // int takeoffQ_idx = get_shortest_queue_idx(takeoffQ, TAKEOFF_Q_COUNT); // 연산 수 증가
-        take_idx += 2;
+    // 할당 부족분 합산 (fit_pool 덕분에 0이어야 함, 생기면 그 비행기 id만 비어 있음)
+    int generated = land_planes_cnt + take_planes_cnt;
+    for (int i = 0; i < LANDING_Q_COUNT; i++)
+        generated -= p->land_short[i];
+    for (int i = 0; i < TAKEOFF_Q_COUNT; i++)
+        generated -= p->take_short[i];
+    dropped += land_planes_cnt + take_planes_cnt - generated;
 
-        enqueue(&takeoffQ[takeoffQ_idx], newNode); // 이륙 큐 삽입
+    g_total_plane_count += generated; // 생성 비행기 수 집계 (큐에 실제로 들어간 수)
+
+    // 보고는 main에서만 (worker는 출력하지 않음)
+    if (dropped > 0) {
+        g_dropped_plane_count += dropped;
+        LOG_SUMMARY_DO(log_kv("[!] Node pool is full (FULL MEMORY), dropped planes: ", dropped));
     }
+    return generated;
 }
 
 // 스택 초기화
 void init_emergency_stack(EmergencyStack *s) {
-    s->top = NULL;
+    atomic_init(&s->top, NULL);
     s->size = 0;
-    pthread_mutex_init(&s->lock, NULL); // lock 초기화: NULL (default)
+    s->push_count = 0;
 }
 
-// 스택 push (lock 필요)
-void push_emergency(EmergencyStack *s, Node *emerg) {
-    pthread_mutex_lock(&s->lock); // lock
-
+// 스택 push
+// worker 버퍼 하나(top ~ tail)를 통째로 올림 (main이 합류 후 큐 순서대로 호출 >> 단일 스레드, 저장 1번)
+void push_emergency(EmergencyStack *s, Node *top, Node *tail, int count) {
     // 사실상 LIFO 구조의 연결리스트
-    emerg->next = s->top; // 긴급한 비행기끼리 연결
-    s->top = emerg;
-    s->size++;
+    tail->next = atomic_load_explicit(&s->top, memory_order_relaxed); // 긴급한 비행기끼리 연결
+    atomic_store_explicit(&s->top, top, memory_order_relaxed);
+    s->size += count;
+    s->push_count += count;
+}
 
-    pthread_mutex_unlock(&s->lock); // unlock
+// worker 전용 긴급 리스트 push (자기 것만 건드리므로 lock, CAS 필요X)
+void push_local_emergency(QueueShard *src, Node *emerg) {
+    emerg->next = src->emerg_top;
+    if (src->emerg_top == NULL)
+        src->emerg_tail = emerg; // 첫 노드가 병합 시 꼬리
+    src->emerg_top = emerg;
+    src->emerg_size++;
 }
 
-// 스택 전체 리스트 pop (하나씩 빼 줄 필요X -> lock 필요X)
+// 스택 전체 리스트 pop (하나씩 빼 줄 필요X -> exchange 1번)
 Node *pop_all_emergency(EmergencyStack *s) {
-
-    if (s->top == NULL)
+    // 다음 tick을 위한 초기화와 동시에 기존 리스트 획득
+    Node *emerg_head = atomic_exchange_explicit(&s->top, NULL, memory_order_acquire);
+    if (emerg_head == NULL)
         return NULL; // 긴급 착륙 비행기가 없던 경우
 
-    // EmergencyStack *emerg_all_copy = s; // 동일한 객체를 가리켜 의미X
-    Node *emerg_head = s->top;
-
-    // 다음 tick을 위한 초기화
-    s->top = NULL;
     s->size = 0;
-
     return emerg_head;
 }
 
@@ -253,8 +1385,10 @@ void heavy_task(void) {
 //// 스레드 함수 (go_..)
 // 연료 감소 및 <0 도달 감지 + 긴급 리스트 연결 수행
 void *go_fuel_dec_and_check(void *arg) {
-    Arg *src = (Arg *)arg; // 스레드 인자 형변환
-    Queue *q = src->q;     // 스레드가 들고온 도착 큐
+    QueueShard *src = (QueueShard *)arg; // 스레드 인자 형변환
+    Queue *q = &src->q;                  // 스레드가 들고온 도착 큐
+    long scanned = 0;                    // 통계는 지역 변수로 모았다가 마지막에 1번 기록
+    long emerg_found = 0;
 
     Node *prev = NULL;
     Node *curr = q->head;
@@ -267,6 +1401,7 @@ void *go_fuel_dec_and_check(void *arg) {
     // dec_and_check
     while (curr != NULL) {
         curr->plane.fuel -= curr->plane.consume;
+        scanned++;
 
         //연료가 부족한 경우
         if (curr->plane.fuel <= 0) {
@@ -288,8 +1423,10 @@ void *go_fuel_dec_and_check(void *arg) {
             curr = curr->next; // curr 재조정 (조건 재탐색)
 
             //@ link
-            // 긴급 스택에 추가 (해당 주소의 next가 변경되므로 마지막에..)
-            push_emergency(&emergS, emergency);
+            // worker 전용 긴급 리스트에 추가 (해당 주소의 next가 변경되므로 마지막에..)
+            // 공유 스택에는 barrier 이후 main이 큐 순서대로 병합 >> 실행마다 순서 동일
+            push_local_emergency(src, emergency);
+            emerg_found++;
         }
         else {
             // printf("[Land: %d] QAD: %p, Fuel: %d\n", test_cnt++, q, curr->plane.fuel);
@@ -297,6 +1434,98 @@ void *go_fuel_dec_and_check(void *arg) {
             curr = curr->next;
         }
     }
+    src->stats.scanned += scanned;
+    src->stats.emerg_found += emerg_found;
+    return NULL;
+}
+
+// 벽시계 시간(sec) 반환 (clock()은 모든 스레드의 CPU 시간을 합산하므로 멀티 스레드 비교에 부적합)
+double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+//// 상주 worker 함수
+// tick마다 start_barrier에서 깨어나 자기 큐만 처리하고 done_barrier에서 합류
+void *go_worker(void *arg) {
+    QueueShard *src = (QueueShard *)arg;
+
+    while (1) {
+        pthread_barrier_wait(&workers.start_barrier); // main의 tick 시작 신호 대기
+        if (workers.quit)
+            break; // 종료 신호
+
+        if (workers.job == WORK_GENERATE)
+            gen_worker(src - landingQ); // 대량 생성 tick: 자기 큐 몫 생성
+        else {
+            double start = now_sec();
+            go_fuel_dec_and_check(src);
+            src->busy_time = now_sec() - start;
+        }
+
+        pthread_barrier_wait(&workers.done_barrier); // main에게 처리 완료 알림
+    }
+    flush_node_cache_stats();
+    return NULL;
+}
+
+// 스레드 풀 생성 (시뮬레이션 시작 시 1번만)
+int init_worker_pool(void) {
+    workers.quit = 0;
+    workers.job = WORK_FUEL;
+    // 참여자: worker LANDING_Q_COUNT개 + main 1개
+    pthread_barrier_init(&workers.start_barrier, NULL, LANDING_Q_COUNT + 1);
+    pthread_barrier_init(&workers.done_barrier, NULL, LANDING_Q_COUNT + 1);
+
+    for (int i = 0; i < LANDING_Q_COUNT; i++) {
+        // worker i는 항상 착륙 큐 샤드 i 담당
+        if (pthread_create(&workers.tid[i], NULL, go_worker, &landingQ[i])) {
+            printf("pthread_create failed.\n");
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// 한 tick의 연료 감소 수행: worker를 깨우고 모두 끝날 때까지 대기
+// 반환값: 가장 오래 걸린 worker의 연산 시간 (dispatch overhead 계산용)
+double run_worker_pool(void) {
+    pthread_barrier_wait(&workers.start_barrier); // worker 출발
+    pthread_barrier_wait(&workers.done_barrier);  // worker 전원 합류
+
+    // 큐 idx 순서대로 worker 긴급 리스트 병합
+    // >> 단일 스레드에서 큐 0번부터 push한 것과 같은 순서 (스레드 타이밍과 무관)
+    double max_busy = 0.0;
+    for (int i = 0; i < LANDING_Q_COUNT; i++) {
+        QueueShard *a = &landingQ[i];
+        if (a->busy_time > max_busy)
+            max_busy = a->busy_time;
+
+        if (a->emerg_top != NULL) {
+            push_emergency(&emergS, a->emerg_top, a->emerg_tail, a->emerg_size);
+            a->emerg_top = NULL; // 다음 tick을 위한 초기화
+            a->emerg_tail = NULL;
+            a->emerg_size = 0;
+        }
+    }
+    return max_busy;
+}
+
+// 스레드 풀 종료 (시뮬레이션 종료 시 1번만)
+int destroy_worker_pool(void) {
+    workers.quit = 1;
+    pthread_barrier_wait(&workers.start_barrier); // quit 확인하도록 깨움
+
+    for (int j = 0; j < LANDING_Q_COUNT; j++) {
+        if (pthread_join(workers.tid[j], NULL)) {
+            printf("pthread_join failed\n");
+            return -1;
+        }
+    }
+    pthread_barrier_destroy(&workers.start_barrier);
+    pthread_barrier_destroy(&workers.done_barrier);
+    return 0;
 }
 
 // 잔여 활주로 수 반환: >0, 0
@@ -313,10 +1542,10 @@ int is_there_remain_runway(int *rw_used) {
 }
 
 // 각 역할 큐 전체 사이즈 참조 비교 (call by ref: 배열 반환이 안되네..)
-void get_total_queue_size(Queue *landQ, Queue *takeQ,
+void get_total_queue_size(QueueShard *landQ, Queue *takeQ,
                           int *l_total_landing_queue_size, int *l_total_takeoff_queue_size) {
     for (int i = 0; i < LANDING_Q_COUNT; i++)
-        *l_total_landing_queue_size += landQ[i].size;
+        *l_total_landing_queue_size += landQ[i].q.size;
     for (int i = 0; i < TAKEOFF_Q_COUNT; i++)
         *l_total_takeoff_queue_size += takeQ[i].size;
 }
@@ -334,29 +1563,144 @@ int get_longest_queue_idx(Queue *q_addr, int q_size) {
     return max_q_idx;
 }
 
-/////////////////// main
-int main(void) {
-    // 프로그램 시작하자마자 버퍼링 끄기
-    setbuf(stdout, NULL);
+// 가장 긴 착륙 큐 샤드의 인덱스 반환 (착륙 시 사용)
+int get_longest_shard_idx(QueueShard *s_addr, int s_size) {
+    int max_q_idx = -1;
+    int max_q_size = -1;
+    for (int i = 0; i < s_size; i++) {
+        if (s_addr[i].q.size > max_q_size) {
+            max_q_idx = i;
+            max_q_size = s_addr[i].q.size;
+        }
+    }
+    return max_q_idx;
+}
+
+//// 큐 배치 벤치마크 (QUEUE_LAYOUT_BENCH)
+// 기존 배치: Queue 배열 + 통계 배열이 빽빽하게 붙어 있음 (여러 worker가 한 캐시 라인 공유)
+// 샤드 배치: worker마다 캐시 라인 정렬된 QueueShard
+// 각 worker가 자기 큐를 한 바퀴씩 돌며 (dequeue > 연료 감소 > 통계 갱신 > enqueue) head/tail/size와 통계를 계속 씀
+typedef struct Bench_arg {
+    Queue *q;
+    volatile long *scanned;     // 매 비행기마다 메모리에 기록 (레지스터 최적화 방지)
+    volatile long *emerg_found;
+} BenchArg;
+
+void *go_bench_scan(void *arg) {
+    BenchArg *b = (BenchArg *)arg;
+
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        int n = b->q->size;
+        for (int k = 0; k < n; k++) {
+            Node *node = dequeue(b->q);
+            node->plane.fuel -= node->plane.consume;
+            (*b->scanned)++;
+            if (node->plane.fuel <= 0) {
+                (*b->emerg_found)++;
+                node->plane.fuel = 68; // 재급유 후 계속 순환
+            }
+            enqueue(b->q, node);
+        }
+    }
+    return NULL;
+}
+
+// 착륙 큐 배열 하나에 대해 worker를 돌려 초당 검사 비행기 수 반환
+double run_bench_scan(BenchArg *args) {
+    pthread_t tid[LANDING_Q_COUNT];
+
+    double start = now_sec();
+    for (int i = 0; i < LANDING_Q_COUNT; i++)
+        pthread_create(&tid[i], NULL, go_bench_scan, &args[i]);
+    for (int i = 0; i < LANDING_Q_COUNT; i++)
+        pthread_join(tid[i], NULL);
+    double elapsed = now_sec() - start;
+
+    return (double)LANDING_Q_COUNT * BENCH_PLANES_PER_Q * BENCH_ROUNDS / elapsed;
+}
+
+int bench_queue_layout(void) {
+    static Queue packedQ[LANDING_Q_COUNT];       // 기존 배치
+    static long packed_stats[LANDING_Q_COUNT][2]; // 기존 배치의 worker 통계 (16byte씩 붙어 있음)
+    BenchArg packed[LANDING_Q_COUNT];
+    BenchArg sharded[LANDING_Q_COUNT];
+
+    // 두 배치에 같은 비행기를 채움 (큐마다 pool의 연속 구간 사용)
+    for (int i = 0; i < LANDING_Q_COUNT; i++) {
+        init_queue(&packedQ[i]);
+        init_queue(&landingQ[i].q);
+        for (int k = 0; k < 2 * BENCH_PLANES_PER_Q; k++) {
+            Node *newNode = alloc_node();
+            if (newNode == NULL) {
+                printf("bench alloc failed (FULL MEMORY)\n");
+                return -1;
+            }
+            uint32_t r[4];
+            rng_block(RNG_BENCH, 0, i, k, r);
+            newNode->plane.idx = 2 * k;
+            newNode->plane.fuel = rng_range(r[0], 49) + 20;
+            newNode->plane.consume = rng_range(r[1], 3) + 3;
+            newNode->plane.type = 0;
+            enqueue((k < BENCH_PLANES_PER_Q) ? &packedQ[i] : &landingQ[i].q, newNode);
+        }
+        packed[i] = (BenchArg){&packedQ[i], &packed_stats[i][0], &packed_stats[i][1]};
+        sharded[i] = (BenchArg){&landingQ[i].q, &landingQ[i].stats.scanned, &landingQ[i].stats.emerg_found};
+    }
 
-    srand(time(NULL));
+    double packed_rate = run_bench_scan(packed);
+    double sharded_rate = run_bench_scan(sharded);
+
+    printf("====[queue layout bench]====\n");
+    printf("sizeof(Queue): %zu, sizeof(QueueShard): %zu\n", sizeof(Queue), sizeof(QueueShard));
+    printf("Packed  : %.0f planes/sec\n", packed_rate);
+    printf("Sharded : %.0f planes/sec (x%.2f)\n", sharded_rate, sharded_rate / packed_rate);
+    return 0;
+}
+
+/////////////////// main
+int main(int argc, char **argv) {
+    // 옵션: --seed N, --replication N (같은 seed + replication이면 출력 재현, 트레이스 헤더에도 기록)
+    if (rng_parse_args(argc, argv))
+        return -1;
     // 풀 초기화
-    init_pool();
+    if (init_pool()) {
+        printf("init_pool failed (mmap)\n");
+        return -1;
+    }
     // 큐 초기화
     for (int i = 0; i < LANDING_Q_COUNT; i++)
-        init_queue(&landingQ[i]);
+        init_queue(&landingQ[i].q);
     for (int i = 0; i < TAKEOFF_Q_COUNT; i++)
         init_queue(&takeoffQ[i]);
     // 긴급 스택 초기화
     init_emergency_stack(&emergS);
 
-    //// 단일 스레드 소요시간 파악
-    double l_total_time = 0.0;
+#if QUEUE_LAYOUT_BENCH
+    return bench_queue_layout();
+#endif
+
+    // 스레드 풀 생성 (1번만)
+    if (init_worker_pool())
+        return -1;
+
+    //// 멀티 스레드 소요시간 파악
+    double l_total_time = 0.0;     // 연료 감소 단계 전체 시간
+    double l_total_dispatch = 0.0; // 그 중 worker 깨우기/합류에 쓴 시간
+    double l_total_gen = 0.0;      // 비행기 생성 단계 시간
+
+    // 출력 스레드 (LOG_ASYNC가 아니면 아무것도 안 함)
+    if (log_writer_start())
+        return -1;
+#if TRACE_ENABLE
+    if (trace_open(g_seed, g_replication))
+        return -1;
+#endif
 
     //// simulation run
+    double run_start = now_sec(); // 출력 포함 전체 시간
     // 틱 마다 한 작업만 수행 (활주로 마다)
     for (int tick = 1; tick <= SIMULATION_DONE; tick++) {
-        printf("%d---------------------One loop start------------------------\n", tick);
+        LOG_TICK_DO(log_tick(tick));
 
         int l_total_landing_latency = 0;     // 평균 착륙 대기시간 집계용
         int l_total_landing_plane_count = 0; // 평균 착륙 대기시간 집계용
@@ -366,34 +1710,20 @@ int main(void) {
 
         int l_total_landing_remaining = 0; // 평균 남은 제한 시간 집계용
 
-        generate_planes(tick); // 0~3대 비행기 이/착륙 큐 삽입, tick: entryTime
+        double gen_start = now_sec();
+        generate_planes(tick); // ARRIVAL_MODEL에 따라 비행기 이/착륙 큐 삽입, tick: entryTime
+        l_total_gen += now_sec() - gen_start;
 
         int rw_used[RUNWAY_COUNT] = {0}; // 활주로 초기화 & used: 1
 
-        pthread_t tid[LANDING_Q_COUNT]; // thread id
-        Arg arg[LANDING_Q_COUNT];       // thread data
-
         //todo============================
-        // thread 생성 및 정보 저장 후 수행
+        // 상주 worker를 깨워서 수행 (tick마다 스레드 생성X)
         //// 연료 감소 & <0 도달 감지 & EmergencyStack 삽입
-        clock_t start_time = clock();
-        for (int i = 0; i < LANDING_Q_COUNT; i++) {
-            arg[i].q = &landingQ[i];
-
-            if (pthread_create(&tid[i], NULL, go_fuel_dec_and_check, &arg[i])) {
-                printf("pthread_create failed.\n");
-                return -1;
-            }
-        }
-        // thread 종료 대기
-        for (int j = 0; j < LANDING_Q_COUNT; j++) {
-            if (pthread_join(tid[j], NULL)) { // Second arg: 반환하는 포인터가 저장되는 포인터 변수
-                printf("pthread_join failed\n");
-                return -1;
-            }
-        }
-        clock_t end_time = clock();
-        l_total_time += (double)(end_time - start_time) / CLOCKS_PER_SEC;
+        double start_time = now_sec();
+        double max_busy = run_worker_pool();
+        double end_time = now_sec();
+        l_total_time += end_time - start_time;
+        l_total_dispatch += (end_time - start_time) - max_busy; // 연산 외의 깨우기/합류 비용
         //todo============================
 
         // 비행기 삽입 후 연산
@@ -412,8 +1742,11 @@ int main(void) {
                 rw_priority[i] = RUNWAY_COUNT - i - 1;
 
             Node *curr = pop_all_emergency(&emergS); // 스택 제거
+            Node *emerg_head = curr;                 // 처리 후 한 번에 반환
+            int emerg_count = 0;
             if (curr == NULL) {
                 // 비어있을 수 없음 (emergS.size>0 이어서)
+                log_writer_stop(); // 출력 순서 유지
                 printf("Emergency Stack is not empty. But pop_all_emergency is NULL.\n");
                 return -1; // 뭔가 잘못됐으니 종료
             }
@@ -430,9 +1763,8 @@ int main(void) {
                     g_total_emergency_plane_count++;                // 긴급 착륙한 비행기 집계
                     l_total_landing_queue_size--;                   // 착륙했으니 감소
 
-                    printf("[!] [EMERGENCY] ID: %d, RW: %d, Fuel: %d, Type: %d\n",
-                           curr->plane.idx, rw_priority[survived_plane_count] + 1,
-                           curr->plane.fuel, curr->plane.type);
+                    LOG_EVENT_DO(log_emergency(&curr->plane, rw_priority[survived_plane_count] + 1));
+                    TRACE_DO(trace_emergency(tick, &curr->plane, rw_priority[survived_plane_count] + 1));
                     survived_plane_count++; //! 출력에서 survived.. 를 사용하기 때문에 출력 후 증가
                 }
                 // 긴급 스택이 3개 이상인 경우: 나머지 다 추락
@@ -440,16 +1772,19 @@ int main(void) {
                     // 추락한 비행기 집계
                     g_total_crashed_plane_count++;
                     l_total_landing_queue_size--; //추락했으니 감소
-                    printf("[X] [CRASHED] ID: %d, Fuel: %d\n", curr->plane.idx, curr->plane.fuel);
+                    LOG_EVENT_DO(log_crashed(&curr->plane));
+                    TRACE_DO(trace_crashed(tick, &curr->plane));
                 }
-                // 정리
-                Node *nextNode = curr->next; // 삭제 전 미리 저장
-                free_node(curr);
+                // 정리: 마지막 노드면 리스트 전체를 free list로 splice
+                Node *nextNode = curr->next; // 반환 전 미리 저장
+                emerg_count++;
+                if (nextNode == NULL)
+                    free_nodes(emerg_head, curr, emerg_count);
                 curr = nextNode; // curr == NULL 은 분기에서 처리 됨
             }
         }
         else {
-            printf("Emerency Stack is empty.\n");
+            LOG_EVENT_DO(log_msg("Emerency Stack is empty.\n"));
         }
 
         //// 일반 착륙 & 이륙 중 큐 길이가 긴 것 우선 처리
@@ -471,19 +1806,25 @@ int main(void) {
             // 착륙: 1, 이륙: 0 (우선순위 편향을 위함)
             int bias_mode = (l_total_landing_queue_size > l_total_takeoff_queue_size) ? 1 : 0;
             Node *target = NULL;
+            Node *done_head = NULL; // 이/착륙 완료 노드 (단계가 끝나면 한 번에 반환)
+            Node *done_tail = NULL;
+            int done_count = 0;
 
             // mode를 통해 우선순위를 두고 매번 긴 큐 탐색
             for (int i = 0; i < remainRW_count; i++) {
 
                 int mode = bias_mode; // 편향 덮어쓰기 방지
+                int src_q = -1;       // 꺼낸 큐 idx (트레이스용)
+                (void)src_q;          // TRACE_ENABLE 0이면 쓰지 않음
 
                 // 활주로가 이륙 전용이면 바로 이륙 프로세스 수행
                 if (remainRW_idx[i] == TAKEOFF_ONLY) {
                     mode = 0; // 얘가 mode를 바꿔줘야 하기 때문에 bias_mode 복사 사용
                     int takeoffQ_idx = get_longest_queue_idx(takeoffQ, TAKEOFF_Q_COUNT);
                     target = dequeue(&takeoffQ[takeoffQ_idx]);
+                    src_q = takeoffQ_idx;
                     if (target == NULL) {
-                        printf("Takeoff is empty.\n");
+                        LOG_EVENT_DO(log_msg("Takeoff is empty.\n"));
                         continue; // 해당 활주로는 이제 쓸 일 없으므로 스킵
                     }
                 }
@@ -492,14 +1833,16 @@ int main(void) {
                     // 착륙 모드면
                     if (mode) {
                         // 매 루프마다 가장 긴 큐를 탐색 (해당 mode의 큐를 모두 소모)
-                        int landingQ_idx = get_longest_queue_idx(landingQ, LANDING_Q_COUNT);
-                        target = dequeue(&landingQ[landingQ_idx]);
+                        int landingQ_idx = get_longest_shard_idx(landingQ, LANDING_Q_COUNT);
+                        target = dequeue(&landingQ[landingQ_idx].q);
+                        src_q = landingQ_idx;
                         // 해당 mode의 모든 큐를 소모했으면 bias_mode 변경
                         if (target == NULL) {
-                            printf("[?] Throw to TAKEOFF.\n");
+                            LOG_EVENT_DO(log_msg("[?] Throw to TAKEOFF.\n"));
                             // 갱신 (target을 설정해서 전달할거임)
                             int takeoffQ_idx = get_longest_queue_idx(takeoffQ, TAKEOFF_Q_COUNT);
                             target = dequeue(&takeoffQ[takeoffQ_idx]);
+                            src_q = takeoffQ_idx;
                             bias_mode = 0; // 편향 변경
                             mode = bias_mode;
                         }
@@ -508,12 +1851,14 @@ int main(void) {
                     else {
                         int takeoffQ_idx = get_longest_queue_idx(takeoffQ, TAKEOFF_Q_COUNT);
                         target = dequeue(&takeoffQ[takeoffQ_idx]);
+                        src_q = takeoffQ_idx;
                         // 해당 mode의 모든 큐를 소모했으면 bias_mode 변경
                         if (target == NULL) {
-                            printf("[?] Throw to LANDING.\n");
+                            LOG_EVENT_DO(log_msg("[?] Throw to LANDING.\n"));
                             // 갱신 (target을 설정해서 전달할거임)
-                            int landingQ_idx = get_longest_queue_idx(landingQ, LANDING_Q_COUNT);
-                            target = dequeue(&landingQ[landingQ_idx]);
+                            int landingQ_idx = get_longest_shard_idx(landingQ, LANDING_Q_COUNT);
+                            target = dequeue(&landingQ[landingQ_idx].q);
+                            src_q = landingQ_idx;
                             bias_mode = 1; // 편향 변경
                             mode = bias_mode;
                         }
@@ -532,9 +1877,8 @@ int main(void) {
                         l_total_landing_plane_count++;                                             // 착륙했으니 증가
                         g_total_landed_count++;
 
-                        printf("[*] [LANDING] ID: %d, RW: %d, Fuel: %d, Type: %d\n",
-                               target->plane.idx, remainRW_idx[i] + 1,
-                               target->plane.fuel, target->plane.type);
+                        LOG_EVENT_DO(log_landing(&target->plane, remainRW_idx[i] + 1));
+                        TRACE_DO(trace_landing(tick, &target->plane, src_q, remainRW_idx[i] + 1));
                     }
                     // 이륙의 경우
                     else {
@@ -542,72 +1886,106 @@ int main(void) {
                         l_total_takeoff_queue_size--;                                // 이륙했으니 감소
                         l_total_takeoff_plane_count++;                               // 이륙했으니 증가
 
-                        printf("[*] [TAKEOFF] ID: %d, RW: %d, Type: %d\n",
-                               target->plane.idx, remainRW_idx[i] + 1, target->plane.type);
+                        LOG_EVENT_DO(log_takeoff(&target->plane, remainRW_idx[i] + 1));
+                        TRACE_DO(trace_takeoff(tick, &target->plane, src_q, remainRW_idx[i] + 1));
                     }
                     // 공통작업이라 뺌
                     rw_used[remainRW_idx[i]] = 1;
-                    free_node(target);
+                    target->next = done_head; // 완료 리스트에 모아둠
+                    if (done_head == NULL)
+                        done_tail = target;
+                    done_head = target;
+                    done_count++;
                 }
                 else {
-                    printf("Takeoff, Landing is all empty.\n");
+                    LOG_EVENT_DO(log_msg("Takeoff, Landing is all empty.\n"));
                 }
             }
+            free_nodes(done_head, done_tail, done_count);
         } // 한 단위 종료
 
-        printf("-----------------------One loop done------------------------\n");
+        LOG_TICK_DO(log_msg("-----------------------One loop done------------------------\n"));
         // 평균 이륙 지연시간, 평균 착륙 지연시간
         if (l_total_takeoff_plane_count == 0) {
-            printf("In this loop TAKEOFF none.\n");
+            LOG_TICK_DO(log_msg("In this loop TAKEOFF none.\n"));
         }
         else {
-            printf("[+] [Avg Takeoff Latency] %d\n",
-                   l_total_takeoff_latency / l_total_takeoff_plane_count);
+            LOG_TICK_DO(log_kv("[+] [Avg Takeoff Latency] ",
+                               l_total_takeoff_latency / l_total_takeoff_plane_count));
         }
 
         // 평균 착륙
         if (l_total_landing_plane_count == 0) {
-            printf("In this loop LANDING none.\n");
+            LOG_TICK_DO(log_msg("In this loop LANDING none.\n"));
         }
         else {
-            printf("[+] [Avg Landing Latentcy] %d\n",
-                   l_total_landing_latency / l_total_landing_plane_count);
-            printf("[+] [Avg Remaining Time Limit] %d\n",
-                   l_total_landing_remaining / l_total_landing_plane_count);
+            LOG_TICK_DO(log_kv("[+] [Avg Landing Latentcy] ",
+                               l_total_landing_latency / l_total_landing_plane_count));
+            LOG_TICK_DO(log_kv("[+] [Avg Remaining Time Limit] ",
+                               l_total_landing_remaining / l_total_landing_plane_count));
         }
 
         // 활주로 점유 상태
-        printf("[+] [Runway Status] [");
-        for (int i = 0; i < RUNWAY_COUNT; i++) {
-            if (i == RUNWAY_COUNT - 1) {
-                printf(" %d", rw_used[i]);
-                break;
-            }
-            printf(" %d, ", rw_used[i]);
-        }
-        printf(" ]\n");
+        LOG_TICK_DO(log_runway_status(rw_used));
 
         // 큐 상태
-        printf("[+] [Total Landing Queue Size] %d\n", l_total_landing_queue_size);
-        printf("[+] [Total Takeoff Queue Size] %d\n", l_total_takeoff_queue_size);
-        printf("\n[&] landed: %d, takeoff: %d, total: %d\n\n", g_total_landed_count,
-               l_total_takeoff_plane_count, g_total_plane_count);
+        LOG_TICK_DO(log_kv("[+] [Total Landing Queue Size] ", l_total_landing_queue_size));
+        LOG_TICK_DO(log_kv("[+] [Total Takeoff Queue Size] ", l_total_takeoff_queue_size));
+        LOG_TICK_DO(log_tick_count(g_total_landed_count, l_total_takeoff_plane_count, g_total_plane_count));
+        TRACE_DO(trace_tick(tick, g_total_plane_count, l_total_landing_queue_size, l_total_takeoff_queue_size));
 
     } // 시뮬레이션 종료
+    log_writer_stop(); // 남은 레코드 출력 (이후 main이 log_buf 사용)
+    TRACE_DO(trace_close());
+    double run_time = now_sec() - run_start;
 
-    printf("\n\n=============[ Simulation is done! Let's check it out! ]=============\n");
-    printf("[Total Emergency Landed]: %d\n", g_total_emergency_plane_count);
-    printf("[Total Crashed Planes] %d\n", g_total_crashed_plane_count);
+    LOG_SUMMARY_DO(log_printf("\n\n=============[ Simulation is done! Let's check it out! ]=============\n"));
+    LOG_SUMMARY_DO(log_printf("[Total Emergency Landed]: %d\n", g_total_emergency_plane_count));
+    LOG_SUMMARY_DO(log_printf("[Total Crashed Planes] %d\n", g_total_crashed_plane_count));
     if (g_total_plane_count == 0) {
-        printf("g_total_plane_count == 0.\n");
+        LOG_SUMMARY_DO(log_printf("g_total_plane_count == 0.\n"));
     }
     else {
-        printf("[Avg Emergency Landed] %lf\n", ((double)g_total_emergency_plane_count / g_total_plane_count * 100.0));
-        printf("[Avg Crashed Planes] %lf\n ", ((double)g_total_crashed_plane_count / g_total_plane_count * 100.0));
+        LOG_SUMMARY_DO(log_printf("[Avg Emergency Landed] %lf\n", ((double)g_total_emergency_plane_count / g_total_plane_count * 100.0)));
+        LOG_SUMMARY_DO(log_printf("[Avg Crashed Planes] %lf\n ", ((double)g_total_crashed_plane_count / g_total_plane_count * 100.0)));
     }
 
-    printf("====[multi thread]====\n");
-    printf("Avg Time: %.6f sec\n", l_total_time / SIMULATION_DONE);
+    if (destroy_worker_pool()) {
+        log_flush_buf();
+        return -1;
+    }
+
+    LOG_SUMMARY_DO(log_printf("====[multi thread]====\n"));
+    LOG_SUMMARY_DO(log_printf("Seed: %llu, Replication: %u\n", (unsigned long long)g_seed, g_replication));
+    LOG_SUMMARY_DO(log_printf("Avg Time: %.6f sec\n", l_total_time / SIMULATION_DONE));
+    LOG_SUMMARY_DO(log_printf("Run Time: %.6f sec (LOG_LEVEL %d)\n", run_time, LOG_LEVEL));
+    LOG_SUMMARY_DO(log_printf("Avg Dispatch Overhead: %.9f sec\n", l_total_dispatch / SIMULATION_DONE));
+    LOG_SUMMARY_DO(log_printf("Avg Generate Time: %.6f sec (parallel ticks: %ld)\n", l_total_gen / SIMULATION_DONE,
+                               g_parallel_gen_count));
+    LOG_SUMMARY_DO(log_printf("Arrival: %s (%.2f planes/tick), Fuel: %s, Burst Ticks: %ld, Clamped Ticks: %ld\n",
+                               arrival_model_name(), (double)g_total_plane_count / SIMULATION_DONE,
+                               FUEL_MODEL == FUEL_PARETO ? "pareto" : "uniform", g_mmpp_burst_ticks,
+                               g_arrival_clamped));
+    LOG_SUMMARY_DO(log_printf("Dropped Planes (FULL MEMORY): %ld\n", g_dropped_plane_count));
+    LOG_SUMMARY_DO(log_printf("Emergency Push: %ld\n", emergS.push_count));
+
+    long l_total_scanned = 0;
+    long l_total_found = 0;
+    for (int i = 0; i < LANDING_Q_COUNT; i++) {
+        l_total_scanned += landingQ[i].stats.scanned;
+        l_total_found += landingQ[i].stats.emerg_found;
+    }
+    LOG_SUMMARY_DO(log_printf("Scanned Planes: %ld, Emergency Found: %ld\n", l_total_scanned, l_total_found));
+
+    flush_node_cache_stats();
+    LOG_SUMMARY_DO(log_printf("Pool Fast Path: %ld, Depot Exchange: %ld (magazine %d nodes), Touched: %d / %d nodes\n",
+                               depot.fast_count, depot.exchange_count, MAG_SIZE, depot.carved, MAX_PLANE_COUNT));
+#if LOG_ASYNC
+    LOG_SUMMARY_DO(log_printf("Log Ring: %d records, Stall: %ld, Dropped: %ld\n",
+                               LOG_RING_SIZE, log_ring.stall_count, log_ring.drop_count));
+#endif
+
+    log_flush_buf();
 }
 
 // int pthread_create(pthread_t* thread,
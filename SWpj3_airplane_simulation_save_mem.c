@@ -1,11 +1,19 @@
 #include <pthread.h>
 #include <stdint.h> // uint8_t를 사용하기 위해 추가 (1byte)
 #include <stdio.h>
-#include <stdlib.h> // random
+#include <string.h> // memcpy
+#include <sys/mman.h> // mmap, madvise
 #include <time.h>
 
+#include "SWpj3_rng.h" // 난수 (Philox, --seed)
+
 #define SIMULATION_DONE 10000     // 시뮬레이션 횟수
-#define MAX_PLANE_COUNT 100000000 // 최대 공존 가능 비행기 수
+#define MAX_PLANE_COUNT 100000000 // 최대 공존 가능 비행기 수 (풀 마다 슬랩 할당 상한)
+#define SLAB_SIZE (64 * 1024)     // 슬랩 크기 (페이지 정렬, 2의 거듭제곱: 노드 주소로 슬랩 헤더 계산)
+#define USE_HUGEPAGE 0            // 1: 풀 영역에 MADV_HUGEPAGE 적용 (THP)
+#define PAGE_BYTES 4096           // madvise 단위 (페이지 크기)
+#define EPOCH_REBASE_AT 0xF000    // tick - epoch가 이 값에 도달하면 epoch 이동 (uint16_t 한계 전)
+#define EPOCH_KEEP 0x8000         // 이동 후 tick - epoch 최대값 (이보다 오래 대기한 비행기는 entryTime을 당김)
 // #define LANDING_Q_COUNT 4       // 착륙 큐 개수
 // #define TAKEOFF_Q_COUNT 3       // 이륙 큐 개수
 // #define RUNWAY_COUNT 3          // 활주로 개수
@@ -20,8 +28,8 @@
 // const int takeoff_only_count = 3;
 
 //@ 공간 복잡도 개선 사항
-// todo: Plane을 Takeoff_Plane, Landing_Plane 으로 구분 + [중요] pool도 나눠야 함
-// todo: >> 메모리를 아낄 수 있음 (fuel, consume: 8byte save)
+// Plane을 Takeoff_Plane, Landing_Plane 으로 구분 + [중요] pool도 나눠야 함
+// >> 메모리를 아낄 수 있음 (fuel, consume: 2byte + 정렬 2byte save)
 // todo: >> 스레드 2개는 비효율적
 // todo: uint16_t: 2byte, uint32_t: 4byte 메모리 낭비 조절
 
@@ -29,30 +37,88 @@
 // todo: thread 세부 분할? > lock 적용 비효율 생각해야 함
 // todo: tree?
 
-// 4 + 2 + 1 + 1 > 8byte
-typedef struct Plane {
-    uint32_t idx;       // 비행기 식별번호(착륙: 짝수, 이륙: 홀수)
-    uint16_t entryTime; // 큐 진입 시간(통계)
+// 착륙 비행기: 4 + 2 + 1 + 1 > 8byte
+typedef struct Landing_plane {
+    uint32_t idx;       // 비행기 식별번호(착륙: 짝수 >> LSB가 type)
+    uint16_t entryTime; // 큐 진입 시간(통계, g_epoch 기준 상대 시간)
     uint8_t fuel;       // 비행기 연료
     uint8_t consume;    // 연료 소모 속도
-} Plane;
-
-// Plane 구조체의 next보다는 Node 구조체를 따로 빼서 next를 하는게 논리적
-typedef struct Node {
-    Plane plane;
-    struct Node *next;
-} Node;
-
-// 착륙 큐, 이륙 큐 // 8byte align
+} LandingPlane;
+
+// 이륙 비행기: 연료 정보 X (4 + 2 > 6byte)
+typedef struct __attribute__((packed)) Takeoff_plane {
+    uint32_t idx;       // 비행기 식별번호(이륙: 홀수 >> LSB가 type)
+    uint16_t entryTime; // 큐 진입 시간(통계, g_epoch 기준 상대 시간)
+} TakeoffPlane;
+
+#define PLANE_LANDING 0
+#define PLANE_TAKEOFF 1
+#define PLANE_TYPE(p) ((p)->idx & 1) // 식별번호 LSB로 type 구분 (type 필드 X)
+
+// 노드: 맨 앞 4byte가 다음 노드의 풀 idx (풀/큐는 레코드 종류와 무관하게 이 부분만 사용)
+// 4 + 8 > 12byte (next를 포인터 대신 풀 idx로: 16byte 대비 25% 절약)
+typedef struct Landing_node {
+    uint32_t next; // 다음 노드의 풀 idx (NIL_IDX: 없음)
+    LandingPlane plane;
+} LandingNode;
+
+// 4 + 6 > 10byte (packed: 착륙 노드 대비 2byte, 기존 16byte 노드 대비 37.5% 절약)
+typedef struct __attribute__((packed)) Takeoff_node {
+    uint32_t next; // 다음 노드의 풀 idx (NIL_IDX: 없음)
+    TakeoffPlane plane;
+} TakeoffNode;
+
+// 풀 idx: 슬랩 번호 << SLAB_NODE_BITS | 슬랩 내 노드 idx
+// >> 풀 안에 절대 주소가 없어서 영역을 옮기거나 공유/스냅샷 가능
+#define NIL_IDX UINT32_MAX
+#define SLAB_NODE_BITS 13 // 슬랩 내 노드 idx 비트 수 (SLAB_NODES < 8192)
+
+// 슬랩: 헤더 + 노드 배열 (SLAB_SIZE 정렬 할당)
+typedef struct Slab {
+    uint32_t prev;       // 가용 슬랩 리스트 (슬랩 번호, 빈 노드가 남은 슬랩만)
+    uint32_t next;
+    uint32_t freed_head; // 슬랩 내부 해제 리스트 (LIFO, 재사용 노드만)
+    int bump;            // 한 번도 안 쓴 노드 시작 idx (bump pointer)
+    int live;            // 사용 중인 노드 수 (0이면 반환 대상)
+    char nodes[];        // 노드 배열 (레코드 크기는 풀마다 다름)
+} Slab;
+
+#define SLAB_NODES(size) ((int)((SLAB_SIZE - sizeof(Slab)) / (size)))                  // 슬랩 당 노드 수
+#define POOL_SLABS(size) ((MAX_PLANE_COUNT + SLAB_NODES(size) - 1) / SLAB_NODES(size)) // 예약 영역의 슬랩 수
+
+// 풀 idx가 32bit 안에 들어가야 함 (레코드가 작을수록 슬랩 당 노드 수가 많음)
+_Static_assert(SLAB_NODES(sizeof(TakeoffNode)) <= (1 << SLAB_NODE_BITS), "SLAB_SIZE too large for SLAB_NODE_BITS");
+_Static_assert(POOL_SLABS(sizeof(LandingNode)) < (1u << (32 - SLAB_NODE_BITS)), "MAX_PLANE_COUNT too large for 32-bit idx");
+
+// 노드 풀: mmap 예약 영역에서 필요할 때 슬랩 단위로 늘리고 다 빈 슬랩은 반환
+// >> 페이지는 실제로 쓴 슬랩만 커밋됨 (시작 시간, RSS가 상한이 아닌 살아있는 비행기 수에 비례)
+typedef struct Slab_pool {
+    const char *name; // 통계 출력용
+    int node_size;    // 레코드 크기
+    int node_count;   // 슬랩 당 노드 수
+    int slab_max;     // 예약 영역의 슬랩 수
+    char *base;       // 예약 영역 시작 (SLAB_SIZE 정렬)
+    char *bump;       // 한 번도 안 쓴 슬랩 시작 (bump pointer)
+    char *end;        // 예약 영역 끝
+    uint32_t empty;   // 반환된 슬랩 리스트 (페이지는 커널에 돌려준 상태)
+    uint32_t avail;   // 가용 슬랩 리스트 head (alloc은 항상 여기서)
+    long slab_count;  // 현재 슬랩 수
+    long slab_peak;   // 최대 슬랩 수
+    long live_nodes;  // 사용 중인 노드 수
+    long live_peak;   // high-water mark
+} SlabPool;
+
+// 착륙 큐, 이륙 큐
 typedef struct Queue {
-    Node *head; // 삭제 수행
-    Node *tail; // 삽입 수행
-    int size;   // 로드 밸런싱
+    uint32_t head;  // 삭제 수행 (풀 idx)
+    uint32_t tail;  // 삽입 수행 (풀 idx)
+    int size;       // 로드 밸런싱
+    SlabPool *pool; // 노드가 속한 풀 (착륙/이륙)
 } Queue;
 
-// 긴급 리스트 ()
+// 긴급 리스트 (착륙 풀)
 typedef struct Stack {
-    Node *top;            // LIFO pointer
+    uint32_t top;         // LIFO (풀 idx)
     int size;             // 통계?
     pthread_mutex_t lock; // 긴급 리스트
 } EmergencyStack;
@@ -63,8 +129,8 @@ typedef struct Thread_arg {
 } Arg;
 
 //// 스레드 공유 자원
-Node pool[MAX_PLANE_COUNT]; // malloc의 연산 부하 해결
-Node *freed_head = pool;    // 해제된 리스트의 헤드(가용 가능한 청크)
+SlabPool landingPool; // malloc의 연산 부하 해결 (고정 배열 대신 슬랩 단위로 확장)
+SlabPool takeoffPool; // 이륙 전용 풀 (연료 스캔은 착륙 풀만 접근)
 // pthread_mutex_t poolMutex = PTHREAD_MUTEX_INITIALIZER;
 
 Queue landingQ[LANDING_Q_COUNT]; // 착륙 큐
@@ -79,77 +145,307 @@ int g_total_crashed_plane_count = 0;   //* 사고 당한 모든 비행기의 수
 
 int g_total_landed_count = 0;
 
-// next를 다음 주소와 연결해주는 작업 (리스트의 장점: 삭제 연산)
-void init_pool(void) {
-    // 마지막 idx직전까지 연결, next는 포인터: 주소를 연결
-    for (int i = 0; i < MAX_PLANE_COUNT - 1; i++) {
-        pool[i].next = &pool[i + 1];
+double g_total_landing_fragmentation = 0; // 틱 마다 풀 단편화율 집계
+double g_total_takeoff_fragmentation = 0;
+
+//@ entryTime 기준 시점 (uint16_t로 65535틱 이상 돌리기 위함)
+int g_epoch = 0;                // entryTime = tick - g_epoch
+long g_epoch_rebase_count = 0;  // epoch 이동 횟수
+long g_epoch_clamped_count = 0; // EPOCH_KEEP보다 오래 대기해서 entryTime을 당긴 비행기 수 (대기 시간 과소 집계)
+
+// 풀 초기화: 주소 공간만 예약 (슬랩은 첫 alloc 때 생성, 노드 연결 X)
+int init_pool(SlabPool *p, const char *name, int node_size) {
+    p->name = name;
+    p->node_size = node_size;
+    p->node_count = SLAB_NODES(node_size);
+    p->slab_max = POOL_SLABS(node_size);
+
+    // SLAB_SIZE 정렬을 위해 슬랩 1개 여유
+    size_t len = (size_t)(p->slab_max + 1) * SLAB_SIZE;
+    char *region = mmap(NULL, len, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (region == MAP_FAILED)
+        return -1;
+#if USE_HUGEPAGE
+    madvise(region, len, MADV_HUGEPAGE); // 실패해도 일반 페이지로 동작
+#endif
+
+    p->base = (char *)(((uintptr_t)region + SLAB_SIZE - 1) & ~(uintptr_t)(SLAB_SIZE - 1));
+    p->bump = p->base;
+    p->end = p->base + (size_t)p->slab_max * SLAB_SIZE;
+    p->empty = NIL_IDX;
+    p->avail = NIL_IDX;
+    p->slab_count = 0;
+    p->slab_peak = 0;
+    p->live_nodes = 0;
+    p->live_peak = 0;
+    return 0;
+}
+
+// 노드의 next (맨 앞 4byte, packed 레코드라 memcpy로 접근)
+uint32_t get_next(void *node) {
+    uint32_t next;
+    memcpy(&next, node, sizeof(next));
+    return next;
+}
+
+void set_next(void *node, uint32_t next) {
+    memcpy(node, &next, sizeof(next));
+}
+
+// 슬랩 번호 > 슬랩 주소
+Slab *slab_at(SlabPool *p, uint32_t slab_no) {
+    return (Slab *)(p->base + (size_t)slab_no * SLAB_SIZE);
+}
+
+// 슬랩 주소 > 슬랩 번호
+uint32_t slab_no(SlabPool *p, Slab *slab) {
+    return (uint32_t)(((char *)slab - p->base) / SLAB_SIZE);
+}
+
+// 노드가 속한 슬랩 (SLAB_SIZE 정렬이라 하위 비트만 지우면 헤더)
+Slab *slab_of(void *node) {
+    return (Slab *)((uintptr_t)node & ~(uintptr_t)(SLAB_SIZE - 1));
+}
+
+// 풀 idx > 노드 주소 (NIL_IDX: NULL)
+void *node_at(SlabPool *p, uint32_t idx) {
+    if (idx == NIL_IDX)
+        return NULL;
+    return slab_at(p, idx >> SLAB_NODE_BITS)->nodes + (size_t)(idx & ((1 << SLAB_NODE_BITS) - 1)) * p->node_size;
+}
+
+// 노드 주소 > 풀 idx
+uint32_t node_idx(SlabPool *p, void *node) {
+    Slab *slab = slab_of(node);
+    return (slab_no(p, slab) << SLAB_NODE_BITS) | (uint32_t)(((char *)node - slab->nodes) / p->node_size);
+}
+
+// 가용 슬랩 리스트 head에 삽입
+void slab_link(SlabPool *p, Slab *slab) {
+    uint32_t no = slab_no(p, slab);
+    slab->prev = NIL_IDX;
+    slab->next = p->avail;
+    if (p->avail != NIL_IDX)
+        slab_at(p, p->avail)->prev = no;
+    p->avail = no;
+}
+
+// 가용 슬랩 리스트에서 제거
+void slab_unlink(SlabPool *p, Slab *slab) {
+    if (slab->prev != NIL_IDX)
+        slab_at(p, slab->prev)->next = slab->next;
+    else
+        p->avail = slab->next;
+    if (slab->next != NIL_IDX)
+        slab_at(p, slab->next)->prev = slab->prev;
+}
+
+// 슬랩 1개 할당: 반환된 슬랩 재사용, 없으면 예약 영역에서 bump (노드는 연결하지 않음)
+Slab *new_slab(SlabPool *p) {
+    Slab *slab;
+    if (p->empty != NIL_IDX) {
+        slab = slab_at(p, p->empty);
+        p->empty = slab->next;
     }
-    // 마지막 idx는 next가 NULL이어야 함.
-    pool[MAX_PLANE_COUNT - 1].next = NULL;
+    else {
+        if (p->bump == p->end)
+            return NULL; // 예약 영역 소진
+        slab = (Slab *)p->bump;
+        p->bump += SLAB_SIZE;
+    }
+
+    slab->freed_head = NIL_IDX;
+    slab->bump = 0;
+    slab->live = 0;
+    slab_link(p, slab);
+
+    p->slab_count++;
+    if (p->slab_count > p->slab_peak)
+        p->slab_peak = p->slab_count;
+    return slab;
 }
 
 // LIFO 구조 노드 반환
-Node *alloc_node(void) {
-    // 가용 가능한 청크가 없는 경우(다 씀)
-    if (freed_head == NULL) {
-        printf("freed_head is NULL (FULL MEMORY)\n");
+void *alloc_node(SlabPool *p) {
+    // 상한 도달 (다 씀)
+    if (p->live_nodes >= MAX_PLANE_COUNT) {
+        printf("%s pool is FULL (MAX_PLANE_COUNT)\n", p->name);
+        return NULL;
+    }
+
+    // 가용 가능한 슬랩이 없는 경우: 슬랩 추가
+    Slab *slab;
+    if (p->avail != NIL_IDX)
+        slab = slab_at(p, p->avail);
+    else if ((slab = new_slab(p)) == NULL) {
+        printf("new_slab failed (FULL MEMORY)\n");
         return NULL;
     }
 
-    // 하나씩 가져가며 pool은 줄어듦.
-    Node *newNode = freed_head;
-    freed_head = freed_head->next;
+    // 재사용 노드 우선 (LIFO), 없으면 한 번도 안 쓴 노드 (bump)
+    void *newNode = node_at(p, slab->freed_head);
+    if (newNode != NULL)
+        slab->freed_head = get_next(newNode);
+    else
+        newNode = slab->nodes + (size_t)slab->bump++ * p->node_size;
+    slab->live++;
+    // 꽉 찬 슬랩은 가용 리스트에서 제외
+    if (slab->live == p->node_count)
+        slab_unlink(p, slab);
+
+    p->live_nodes++;
+    if (p->live_nodes > p->live_peak)
+        p->live_peak = p->live_nodes;
 
     // 배열에서 떼어내 연결리스트로 사용할 것이기 때문에 기존 연결을 끊어줘야 함.
-    newNode->next = NULL;
+    set_next(newNode, NIL_IDX);
     return newNode;
 }
 
 // LIFO 구조 노드 해제 및 재사용을 위한 연결
-void free_node(Node *temp) {
+void free_node(SlabPool *p, void *temp) {
+    Slab *slab = slab_of(temp);
+
+    // 꽉 찼던 슬랩: 다시 가용 리스트로
+    if (slab->live == p->node_count)
+        slab_link(p, slab);
+
     // 해제된 청크를 다시 사용 (LIFO)
-    temp->next = freed_head;
-    freed_head = temp;
+    set_next(temp, slab->freed_head);
+    slab->freed_head = node_idx(p, temp);
+    slab->live--;
+    p->live_nodes--;
+
+    // 다 빈 슬랩 반환 (가용 슬랩이 이것 하나면 남겨둠: 할당/반환 반복 방지)
+    if (slab->live == 0 && (slab->prev != NIL_IDX || slab->next != NIL_IDX)) {
+        slab_unlink(p, slab);
+        // 헤더 페이지는 남기고 노드 페이지만 커널에 반환 (다음 사용 시 0 페이지로 다시 커밋)
+        char *page = (char *)(((uintptr_t)slab->nodes + PAGE_BYTES - 1) & ~(uintptr_t)(PAGE_BYTES - 1));
+        madvise(page, (char *)slab + SLAB_SIZE - page, MADV_DONTNEED);
+        slab->next = p->empty;
+        p->empty = slab_no(p, slab);
+        p->slab_count--;
+    }
+}
+
+// 풀 단편화율: 할당된 슬랩 중 사용하지 않는 노드 비율 (%)
+double get_pool_fragmentation(SlabPool *p) {
+    long capacity = p->slab_count * p->node_count;
+    if (capacity == 0)
+        return 0;
+    return (double)(capacity - p->live_nodes) / capacity * 100.0;
+}
+
+// 풀 통계 출력
+void print_pool_stats(SlabPool *p, double total_fragmentation) {
+    printf("Pool[%s] Slabs: %ld (peak %ld, %d nodes/slab, %d B/node), High-Water: %ld nodes (%.2f MB)\n",
+           p->name, p->slab_count, p->slab_peak, p->node_count, p->node_size,
+           p->live_peak, (double)p->slab_peak * SLAB_SIZE / (1024 * 1024));
+    printf("Pool[%s] Fragmentation: %.2f%% (avg %.2f%%)\n",
+           p->name, get_pool_fragmentation(p), total_fragmentation / SIMULATION_DONE);
+    printf("Pool[%s] Reserved: %.2f MB (%d slabs)\n",
+           p->name, (double)(p->end - p->base) / (1024 * 1024), p->slab_max);
 }
 
 // FIFO 구조 큐 초기화
-void init_queue(Queue *queue) {
-    queue->head = NULL;
-    queue->tail = NULL;
+void init_queue(Queue *queue, SlabPool *pool) {
+    queue->head = NIL_IDX;
+    queue->tail = NIL_IDX;
     queue->size = 0;
+    queue->pool = pool;
 }
 
 // FIFO 구조 큐 삽입
-void enqueue(Queue *queue, Node *temp) {
-    if (queue->tail == NULL) {
+void enqueue(Queue *queue, void *temp) {
+    uint32_t idx = node_idx(queue->pool, temp);
+    set_next(temp, NIL_IDX); // 기존 연결이 있을 수 있으니 해제
+    if (queue->tail == NIL_IDX) {
         // tail에 아무것도 없는 경우
-        queue->head = temp; //head 조정
-        queue->tail = temp;
+        queue->head = idx; //head 조정
+        queue->tail = idx;
         queue->size++;
         return;
     }
-    temp->next = NULL; // 기존 연결이 있을 수 있으니 해제
-    queue->tail->next = temp;
-    queue->tail = temp;
+    set_next(node_at(queue->pool, queue->tail), idx);
+    queue->tail = idx;
     queue->size++;
 }
 
 // FIFO 구조 큐 삭제
-Node *dequeue(Queue *queue) {
-    if (queue->head == NULL)
+void *dequeue(Queue *queue) {
+    if (queue->head == NIL_IDX)
         return NULL; // head에 아무것도 없는 경우
 
-    Node *node = queue->head;
-    queue->head = queue->head->next;
+    void *node = node_at(queue->pool, queue->head);
+    queue->head = get_next(node);
 
-    if (queue->head == NULL)
-        queue->tail = NULL; // tail 조정
+    if (queue->head == NIL_IDX)
+        queue->tail = NIL_IDX; // tail 조정
     queue->size--;
 
     return node;
 }
 
+// tick > epoch 기준 상대 시간
+uint16_t to_epoch_time(int tick) {
+    return (uint16_t)(tick - g_epoch);
+}
+
+// epoch 기준 상대 시간 > tick
+int from_epoch_time(uint16_t entryTime) {
+    return g_epoch + entryTime;
+}
+
+// 대기 중인 비행기 중 가장 오래된 entryTime (shift보다 작을 때만 갱신)
+int get_min_entry_time(int shift) {
+    for (int i = 0; i < LANDING_Q_COUNT; i++)
+        for (LandingNode *n = node_at(&landingPool, landingQ[i].head); n != NULL; n = node_at(&landingPool, n->next))
+            if (n->plane.entryTime < shift)
+                shift = n->plane.entryTime;
+    for (int i = 0; i < TAKEOFF_Q_COUNT; i++)
+        for (TakeoffNode *n = node_at(&takeoffPool, takeoffQ[i].head); n != NULL; n = node_at(&takeoffPool, get_next(n)))
+            if (n->plane.entryTime < shift)
+                shift = n->plane.entryTime;
+    return shift;
+}
+
+// 대기 중인 비행기의 entryTime을 shift만큼 당김 (더 오래된 비행기는 새 epoch로 고정)
+void shift_entry_time(int shift) {
+    for (int i = 0; i < LANDING_Q_COUNT; i++)
+        for (LandingNode *n = node_at(&landingPool, landingQ[i].head); n != NULL; n = node_at(&landingPool, n->next)) {
+            if (n->plane.entryTime < shift) {
+                n->plane.entryTime = 0;
+                g_epoch_clamped_count++;
+            }
+            else
+                n->plane.entryTime -= shift;
+        }
+    for (int i = 0; i < TAKEOFF_Q_COUNT; i++)
+        for (TakeoffNode *n = node_at(&takeoffPool, takeoffQ[i].head); n != NULL; n = node_at(&takeoffPool, get_next(n))) {
+            if (n->plane.entryTime < shift) {
+                n->plane.entryTime = 0;
+                g_epoch_clamped_count++;
+            }
+            else
+                n->plane.entryTime -= shift;
+        }
+}
+
+// epoch 이동: 새 epoch = 가장 오래 대기한 비행기 시점 (EPOCH_REBASE_AT - EPOCH_KEEP 틱마다 최대 1번)
+// >> 큐 전체 순회지만 수만 틱에 1번이라 틱 당 비용은 무시 가능
+void rebase_epoch(int tick) {
+    int shift = get_min_entry_time(tick - g_epoch);
+    // 최소 이동: 이동 후 tick - epoch <= EPOCH_KEEP (다음 이동까지 여유 확보)
+    int min_shift = tick - g_epoch - EPOCH_KEEP;
+    if (shift < min_shift)
+        shift = min_shift;
+
+    shift_entry_time(shift);
+    g_epoch += shift;
+    g_epoch_rebase_count++;
+}
+
 // 가장 짧은 큐의 인덱스 반환 (비행기 생성 시 사용)
 int get_shortest_queue_idx(Queue *q_addr, int q_size) {
     int min_q_idx = -1;
@@ -168,8 +464,10 @@ int generate_planes(int entryTime) {
     static int land_idx = 2; // 착륙: 짝수 정수
     static int take_idx = 1; // 이륙: 홀수 정수
 
-    int land_planes_cnt = rand() % 6; //0~3
-    int take_planes_cnt = rand() % 6;
+    // 난수는 multi_thread와 같은 스트림 (SWpj3_rng.h) >> 같은 --seed면 변형끼리 출력 diff 가능
+    Rng arrival = rng_stream(RNG_ARRIVAL, entryTime, 0);    // sub 0: 균등 도착 수 (이/착륙 공용)
+    int land_planes_cnt = rng_range(rng_next(&arrival), 6); // 0~5
+    int take_planes_cnt = rng_range(rng_next(&arrival), 6);
 
     g_total_plane_count += (land_planes_cnt + take_planes_cnt); // 생성 비행기 수 집계
 
@@ -178,11 +476,17 @@ int generate_planes(int entryTime) {
 
     // 착륙 비행기 정보 기입
     for (int i = 0; i < land_planes_cnt; i++) {
-        Node *newNode = alloc_node(); // Node 할당
+        uint32_t r[4];
+        rng_block(RNG_LANDING_PLANE, entryTime, 0, i, r); // 비행기마다 블록 1개 (tick 내 순번 i)
+        LandingNode *newNode = alloc_node(&landingPool); // Node 할당
+        if (newNode == NULL) {
+            g_total_plane_count -= (land_planes_cnt - i); // 생성 못한 비행기 제외
+            break;
+        }
         newNode->plane.idx = land_idx;
-        newNode->plane.fuel = rand() % 49 + 20;  // 20~68
-        newNode->plane.entryTime = entryTime;    // 생성 시점(통계)
-        newNode->plane.consume = rand() % 3 + 3; // 1~3: 0이 되면 안됨
+        newNode->plane.fuel = rng_range(r[0], 49) + 20;      // 20~68
+        newNode->plane.entryTime = to_epoch_time(entryTime); // 생성 시점(통계)
+        newNode->plane.consume = rng_range(r[1], 3) + 3;     // 1~3: 0이 되면 안됨
 
         // int landingQ_idx = get_shortest_queue_idx(landingQ, LANDING_Q_COUNT); // 연산 수 증가
         land_idx += 2;
@@ -190,9 +494,13 @@ int generate_planes(int entryTime) {
     }
     //이륙 비행기 정보 기입
     for (int i = 0; i < take_planes_cnt; i++) {
-        Node *newNode = alloc_node();
+        TakeoffNode *newNode = alloc_node(&takeoffPool);
+        if (newNode == NULL) {
+            g_total_plane_count -= (take_planes_cnt - i); // 생성 못한 비행기 제외
+            break;
+        }
         newNode->plane.idx = take_idx;
-        newNode->plane.entryTime = entryTime;
+        newNode->plane.entryTime = to_epoch_time(entryTime);
 
         // int takeoffQ_idx = get_shortest_queue_idx(takeoffQ, TAKEOFF_Q_COUNT); // 연산 수 증가
         take_idx += 2;
@@ -203,34 +511,34 @@ int generate_planes(int entryTime) {
 
 // 스택 초기화
 void init_emergency_stack(EmergencyStack *s) {
-    s->top = NULL;
+    s->top = NIL_IDX;
     s->size = 0;
     pthread_mutex_init(&s->lock, NULL); // lock 초기화: NULL (default)
 }
 
 // 스택 push (lock 필요)
-void push_emergency(EmergencyStack *s, Node *emerg) {
+void push_emergency(EmergencyStack *s, LandingNode *emerg) {
     pthread_mutex_lock(&s->lock); // lock
 
     // 사실상 LIFO 구조의 연결리스트
     emerg->next = s->top; // 긴급한 비행기끼리 연결
-    s->top = emerg;
+    s->top = node_idx(&landingPool, emerg);
     s->size++;
 
     pthread_mutex_unlock(&s->lock); // unlock
 }
 
 // 스택 전체 리스트 pop (하나씩 빼 줄 필요X -> lock 필요X)
-Node *pop_all_emergency(EmergencyStack *s) {
+LandingNode *pop_all_emergency(EmergencyStack *s) {
 
-    if (s->top == NULL)
+    if (s->top == NIL_IDX)
         return NULL; // 긴급 착륙 비행기가 없던 경우
 
     // EmergencyStack *emerg_all_copy = s; // 동일한 객체를 가리켜 의미X
-    Node *emerg_head = s->top;
+    LandingNode *emerg_head = node_at(&landingPool, s->top);
 
     // 다음 tick을 위한 초기화
-    s->top = NULL;
+    s->top = NIL_IDX;
     s->size = 0;
 
     return emerg_head;
@@ -242,8 +550,10 @@ void *go_fuel_dec_and_check(void *arg) {
     Arg *src = (Arg *)arg; // 스레드 인자 형변환
     Queue *q = src->q;     // 스레드가 들고온 도착 큐
 
-    Node *prev = NULL;
-    Node *curr = q->head;
+    LandingNode *prev = NULL;
+    uint32_t prev_idx = NIL_IDX;
+    uint32_t curr_idx = q->head;
+    LandingNode *curr = node_at(q->pool, curr_idx);
 
     int test_cnt = 0;
     // dec_and_check
@@ -252,7 +562,7 @@ void *go_fuel_dec_and_check(void *arg) {
 
         //연료가 부족한 경우
         if (curr->plane.fuel <= 0) {
-            Node *emergency = curr; // next가 변경되기 전에 복사
+            LandingNode *emergency = curr; // next가 변경되기 전에 복사
 
             //@ unlink
             // 맨 앞인 경우: 도착 큐 head 조정
@@ -263,11 +573,12 @@ void *go_fuel_dec_and_check(void *arg) {
                 prev->next = curr->next;
             }
             // 맨 마지막인 경우: 도착 큐 tail 조정
-            if (curr == q->tail) {
-                q->tail = prev;
+            if (curr_idx == q->tail) {
+                q->tail = prev_idx;
             }
             q->size--;
-            curr = curr->next; // curr 재조정 (조건 재탐색)
+            curr_idx = curr->next; // curr 재조정 (조건 재탐색)
+            curr = node_at(q->pool, curr_idx);
 
             //@ link
             // 긴급 스택에 추가 (해당 주소의 next가 변경되므로 마지막에..)
@@ -276,7 +587,9 @@ void *go_fuel_dec_and_check(void *arg) {
         else {
             // printf("[Land: %d] QAD: %p, Fuel: %d\n", test_cnt++, q, curr->plane.fuel);
             prev = curr;
-            curr = curr->next;
+            prev_idx = curr_idx;
+            curr_idx = curr->next;
+            curr = node_at(q->pool, curr_idx);
         }
     }
 }
@@ -316,19 +629,34 @@ int get_longest_queue_idx(Queue *q_addr, int q_size) {
     return max_q_idx;
 }
 
+// 벽시계 시간(sec) 반환
+double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
 /////////////////// main
-int main(void) {
+int main(int argc, char **argv) {
     // 프로그램 시작하자마자 버퍼링 끄기
     setbuf(stdout, NULL);
 
-    srand(time(NULL));
-    // 풀 초기화
-    init_pool();
+    // 옵션: --seed N, --replication N (multi_thread와 같은 seed면 같은 비행기 생성)
+    if (rng_parse_args(argc, argv))
+        return -1;
+    // 풀 초기화 (주소 공간 예약만: 상한과 무관하게 즉시 끝남)
+    double pool_start = now_sec();
+    if (init_pool(&landingPool, "landing", sizeof(LandingNode)) ||
+        init_pool(&takeoffPool, "takeoff", sizeof(TakeoffNode))) {
+        printf("init_pool failed (mmap)\n");
+        return -1;
+    }
+    double pool_init_time = now_sec() - pool_start;
     // 큐 초기화
     for (int i = 0; i < LANDING_Q_COUNT; i++)
-        init_queue(&landingQ[i]);
+        init_queue(&landingQ[i], &landingPool);
     for (int i = 0; i < TAKEOFF_Q_COUNT; i++)
-        init_queue(&takeoffQ[i]);
+        init_queue(&takeoffQ[i], &takeoffPool);
     // 긴급 스택 초기화
     init_emergency_stack(&emergS);
 
@@ -345,6 +673,10 @@ int main(void) {
 
         int l_total_landing_remaining = 0; // 평균 남은 제한 시간 집계용
 
+        // entryTime이 uint16_t 한계에 가까워지면 epoch 이동
+        if (tick - g_epoch >= EPOCH_REBASE_AT)
+            rebase_epoch(tick);
+
         generate_planes(tick); // 0~3대 비행기 이/착륙 큐 삽입, tick: entryTime
 
         int rw_used[RUNWAY_COUNT] = {0}; // 활주로 초기화 & used: 1
@@ -385,7 +717,7 @@ int main(void) {
             for (int i = 0; i < RUNWAY_COUNT; i++)
                 rw_priority[i] = RUNWAY_COUNT - i - 1;
 
-            Node *curr = pop_all_emergency(&emergS); // 스택 제거
+            LandingNode *curr = pop_all_emergency(&emergS); // 스택 제거
             if (curr == NULL) {
                 // 비어있을 수 없음 (emergS.size>0 이어서)
                 printf("Emergency Stack is not empty. But pop_all_emergency is NULL.\n");
@@ -417,8 +749,8 @@ int main(void) {
                     printf("[X] [CRASHED] ID: %d, Fuel: %d\n", curr->plane.idx, curr->plane.fuel);
                 }
                 // 정리
-                Node *nextNode = curr->next; // 삭제 전 미리 저장
-                free_node(curr);
+                LandingNode *nextNode = node_at(&landingPool, curr->next); // 삭제 전 미리 저장
+                free_node(&landingPool, curr);
                 curr = nextNode; // curr == NULL 은 분기에서 처리 됨
             }
         }
@@ -444,7 +776,7 @@ int main(void) {
 
             // 착륙: 1, 이륙: 0 (우선순위 편향을 위함)
             int bias_mode = (l_total_landing_queue_size > l_total_takeoff_queue_size) ? 1 : 0;
-            Node *target = NULL;
+            void *target = NULL; // mode에 따라 LandingNode / TakeoffNode
 
             // mode를 통해 우선순위를 두고 매번 긴 큐 탐색
             for (int i = 0; i < remainRW_count; i++) {
@@ -499,29 +831,33 @@ int main(void) {
                 //! 이/착륙 큐가 모두 빈 경우: target == NULL인 경우 발생
                 //! 이륙 전용 활주로의 경우: target == NULL인 경우 발생
                 if (target != NULL) {
+                    // 착륙 큐에서 꺼낸 경우 (착륙 풀)
                     if (mode) {
-                        l_total_landing_remaining += (target->plane.fuel / target->plane.consume); // 남은 제한시간 집계
-                        l_total_landing_latency += (tick - target->plane.entryTime);               // 착륙 대기 시간 집계
-                        l_total_landing_queue_size--;                                              // 착륙했으니 감소
-                        l_total_landing_plane_count++;                                             // 착륙했으니 증가
+                        LandingNode *land = target;
+                        l_total_landing_remaining += (land->plane.fuel / land->plane.consume);      // 남은 제한시간 집계
+                        l_total_landing_latency += (tick - from_epoch_time(land->plane.entryTime)); // 착륙 대기 시간 집계
+                        l_total_landing_queue_size--;                                               // 착륙했으니 감소
+                        l_total_landing_plane_count++;                                              // 착륙했으니 증가
                         g_total_landed_count++;
 
                         printf("[*] [LANDING] ID: %d, RW: %d, Fuel: %d\n",
-                               target->plane.idx, remainRW_idx[i] + 1,
-                               target->plane.fuel);
+                               land->plane.idx, remainRW_idx[i] + 1,
+                               land->plane.fuel);
+                        free_node(&landingPool, land);
                     }
-                    // 이륙의 경우
+                    // 이륙의 경우 (이륙 풀)
                     else {
-                        l_total_takeoff_latency += (tick - target->plane.entryTime); // 이륙 대기 시간 집계
-                        l_total_takeoff_queue_size--;                                // 이륙했으니 감소
-                        l_total_takeoff_plane_count++;                               // 이륙했으니 증가
+                        TakeoffNode *take = target;
+                        l_total_takeoff_latency += (tick - from_epoch_time(take->plane.entryTime)); // 이륙 대기 시간 집계
+                        l_total_takeoff_queue_size--;                                               // 이륙했으니 감소
+                        l_total_takeoff_plane_count++;                                              // 이륙했으니 증가
 
                         printf("[*] [TAKEOFF] ID: %d, RW: %d\n",
-                               target->plane.idx, remainRW_idx[i] + 1);
+                               take->plane.idx, remainRW_idx[i] + 1);
+                        free_node(&takeoffPool, take);
                     }
                     // 공통작업이라 뺌
                     rw_used[remainRW_idx[i]] = 1;
-                    free_node(target);
                 }
                 else {
                     printf("Takeoff, Landing is all empty.\n");
@@ -564,6 +900,8 @@ int main(void) {
         // 큐 상태
         printf("[+] [Total Landing Queue Size] %d\n", l_total_landing_queue_size);
         printf("[+] [Total Takeoff Queue Size] %d\n", l_total_takeoff_queue_size);
+        g_total_landing_fragmentation += get_pool_fragmentation(&landingPool); // 풀 단편화율 집계
+        g_total_takeoff_fragmentation += get_pool_fragmentation(&takeoffPool);
         printf("\n[&] landed: %d, takeoff: %d, total: %d\n\n", g_total_landed_count,
                l_total_takeoff_plane_count, g_total_plane_count);
 
@@ -579,6 +917,12 @@ int main(void) {
         printf("[Avg Emergency Landed] %lf\n", ((double)g_total_emergency_plane_count / g_total_plane_count * 100.0));
         printf("[Avg Crashed Planes] %lf\n ", ((double)g_total_crashed_plane_count / g_total_plane_count * 100.0));
     }
+    printf("Seed: %llu, Replication: %u\n", (unsigned long long)g_seed, g_replication);
+    print_pool_stats(&landingPool, g_total_landing_fragmentation);
+    print_pool_stats(&takeoffPool, g_total_takeoff_fragmentation);
+    printf("Pool Init Time: %.6f sec\n", pool_init_time);
+    printf("Epoch Rebase: %ld (epoch %d), Clamped Entry Times: %ld\n",
+           g_epoch_rebase_count, g_epoch, g_epoch_clamped_count);
 }
 
 // int pthread_create(pthread_t* thread,
@@ -1,8 +1,9 @@
 #include <stdint.h> // uint8_t를 사용하기 위해 추가 (1byte)
 #include <stdio.h>
-#include <stdlib.h> // random
 #include <time.h>
 
+#include "SWpj3_rng.h" // 난수 (Philox, --seed)
+
 #define SIMULATION_DONE 500     // 시뮬레이션 횟수
 #define MAX_PLANE_COUNT 1000000 // 최대 공존 가능 비행기 수
 // #define LANDING_Q_COUNT 4       // 착륙 큐 개수
@@ -164,8 +165,10 @@ int generate_planes(int entryTime) {
     static int land_idx = 2; // 착륙: 짝수 정수
     static int take_idx = 1; // 이륙: 홀수 정수
 
-    int land_planes_cnt = rand() % 6; //0~3
-    int take_planes_cnt = rand() % 6;
+    // 난수는 multi_thread와 같은 스트림 (SWpj3_rng.h) >> 같은 --seed면 변형끼리 출력 diff 가능
+    Rng arrival = rng_stream(RNG_ARRIVAL, entryTime, 0);    // sub 0: 균등 도착 수 (이/착륙 공용)
+    int land_planes_cnt = rng_range(rng_next(&arrival), 6); // 0~5
+    int take_planes_cnt = rng_range(rng_next(&arrival), 6);
 
     g_total_plane_count += (land_planes_cnt + take_planes_cnt); // 생성 비행기 수 집계
 
@@ -174,12 +177,14 @@ int generate_planes(int entryTime) {
 
     // 착륙 비행기 정보 기입
     for (int i = 0; i < land_planes_cnt; i++) {
+        uint32_t r[4];
+        rng_block(RNG_LANDING_PLANE, entryTime, 0, i, r); // 비행기마다 블록 1개 (tick 내 순번 i)
         Node *newNode = alloc_node(); // Node 할당
         newNode->plane.idx = land_idx;
-        newNode->plane.fuel = rand() % 49 + 20;  // 20~68
-        newNode->plane.entryTime = entryTime;    // 생성 시점(통계)
-        newNode->plane.consume = rand() % 3 + 3; // 1~3: 0이 되면 안됨
-        newNode->plane.type = 0;                 // 착륙: 0
+        newNode->plane.fuel = rng_range(r[0], 49) + 20;  // 20~68
+        newNode->plane.entryTime = entryTime;            // 생성 시점(통계)
+        newNode->plane.consume = rng_range(r[1], 3) + 3; // 1~3: 0이 되면 안됨
+        newNode->plane.type = 0;                         // 착륙: 0
 
         // int landingQ_idx = get_shortest_queue_idx(landingQ, LANDING_Q_COUNT); // 연산 수 증가
         land_idx += 2;
@@ -292,6 +297,13 @@ void go_fuel_dec_and_check(Queue *q) {
     }
 }
 
+// 벽시계 시간(sec) 반환 (멀티 스레드 버전과 같은 기준으로 비교)
+double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
 // 잔여 활주로 수 반환: >0, 0
 int is_there_remain_runway(int *rw_used) {
     int remainRW = 0;
@@ -328,11 +340,13 @@ int get_longest_queue_idx(Queue *q_addr, int q_size) {
 }
 
 /////////////////// main
-int main(void) {
+int main(int argc, char **argv) {
     // 프로그램 시작하자마자 버퍼링 끄기
     setbuf(stdout, NULL);
 
-    srand(time(NULL));
+    // 옵션: --seed N, --replication N (multi_thread와 같은 seed면 같은 비행기 생성)
+    if (rng_parse_args(argc, argv))
+        return -1;
     // 풀 초기화
     init_pool();
     // 큐 초기화
@@ -367,12 +381,12 @@ int main(void) {
         //-- thread 생성 및 정보 저장 후 수행
         //// 단일 스레드 수행
         //// 연료 감소 & <0 도달 감지 & EmergencyStack 삽입
-        clock_t start_time = clock();
+        double start_time = now_sec();
         for (int i = 0; i < LANDING_Q_COUNT; i++) {
             go_fuel_dec_and_check(&landingQ[i]);
         }
-        clock_t end_time = clock();
-        l_total_time += (double)(end_time - start_time) / CLOCKS_PER_SEC;
+        double end_time = now_sec();
+        l_total_time += end_time - start_time;
         //todo============================
 
         // 비행기 삽입 후 연산
@@ -586,6 +600,7 @@ int main(void) {
     }
 
     printf("====[single thread]====\n");
+    printf("Seed: %llu, Replication: %u\n", (unsigned long long)g_seed, g_replication);
     printf("Avg Time: %.6f sec\n", l_total_time / SIMULATION_DONE);
 }
 
@@ -0,0 +1,964 @@
+#include <pthread.h>
+#include <stdint.h> // uint8_t를 사용하기 위해 추가 (1byte)
+#include <stdio.h>
+#include <stdlib.h> // malloc
+#include <string.h> // memmove
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h> // SSE2, AVX2 (연료 감소 벡터 연산)
+#endif
+
+#include "SWpj3_rng.h" // 난수 (Philox, --seed)
+
+#define SIMULATION_DONE 500     // 시뮬레이션 횟수
+#define MAX_PLANE_COUNT 1000000 // 최대 공존 가능 비행기 수 (이륙 pool)
+// #define LANDING_Q_COUNT 4       // 착륙 큐 개수
+// #define TAKEOFF_Q_COUNT 3       // 이륙 큐 개수
+// #define RUNWAY_COUNT 3          // 활주로 개수
+#define LANDING_Q_COUNT 8 // 착륙 큐 개수
+#define TAKEOFF_Q_COUNT 5 // 이륙 큐 개수
+#define RUNWAY_COUNT 5    // 활주로 개수
+#define TAKEOFF_ONLY 4    // 이륙 전용 활주로 설정 (idx로 지정)
+
+#define CACHE_LINE_SIZE 64 // worker별 자원을 캐시 라인 단위로 분리 (false sharing 방지)
+#define SOA_INIT_CAP 64    // 착륙 큐 배열 초기 용량 (부족하면 2배씩 증가)
+#define FORCE_SCALAR_SCAN 0 // 1: CPUID와 무관하게 scalar 연료 감소 사용 (비교용)
+
+//@ TAKEOFF_ONLY 여러개 설정법
+// #define MAX_TAKEOFF_ONLY 3
+// const int takeoff_only_rw[MAX_TAKEOFF_ONLY] = {1,3,5};
+// const int takeoff_only_count = 3;
+
+//@ 공간 복잡도 개선 사항
+// todo: Plane을 Takeoff_Plane, Landing_Plane 으로 구분 + [중요] pool도 나눠야 함
+// todo: >> 메모리를 아낄 수 있음 (fuel, consume: 8byte save)
+// todo: >> 스레드 2개는 비효율적
+// todo: uint16_t: 2byte, uint32_t: 4byte 메모리 낭비 조절
+
+//@ 시간 복잡도 개선 사항
+// todo: thread 세부 분할? > lock 적용 비효율 생각해야 함
+// todo: tree?
+
+// 4*3 + 1*2 = 14 >> 16바이트 정렬
+// int만 사용하는 것 보다 16바이트 세이브 가능
+//+ type을 없앨 수도 있음 (홀수: lsb=1, 짝수: lsb=0)
+typedef struct Plane {
+    int idx;       // 비행기 식별번호(착륙: 짝수, 이륙: 홀수)
+    int fuel;      // 비행기 연료
+    int entryTime; // 큐 진입 시간(통계)
+    int consume;   // 연료 소모 속도
+    int type;      // 착륙: 0, 이륙: 1 (idx를 이용한 비교X)
+} Plane;
+
+// Plane 구조체의 next보다는 Node 구조체를 따로 빼서 next를 하는게 논리적
+typedef struct Node {
+    Plane plane;
+    struct Node *next;
+} Node;
+
+// 착륙 큐, 이륙 큐
+typedef struct Queue {
+    Node *head; // 삭제 수행
+    Node *tail; // 삽입 수행
+    int size;   // 로드 밸런싱
+} Queue;
+
+// 착륙 큐 (SoA: Structure of Arrays)
+// Node 연결리스트는 alloc/free가 반복되면 pool 안에서 이웃 노드가 흩어져 포인터를 따라다녀야 함
+// >> 필드별 연속 배열 [head, tail)에 FIFO 순서대로 저장, 연료 감소는 배열을 앞에서부터 한 번 훑기
+// fuel: 20~68, consume: 3~5 >> int8_t로 충분 (감소 후 최소 -5)
+typedef struct Soa_queue {
+    int8_t *fuel;       // 비행기 연료
+    int8_t *consume;    // 연료 소모 속도
+    uint32_t *idx;      // 비행기 식별번호(착륙: 짝수)
+    int32_t *entryTime; // 큐 진입 시간(통계)
+    int head;           // 삭제 수행 (FIFO 맨 앞 위치)
+    int tail;           // 삽입 수행 (마지막 다음 위치)
+    int cap;            // 배열 용량
+    int size;           // 로드 밸런싱 (tail - head)
+} SoaQueue;
+
+// 긴급 리스트 (배열: 발견 순서대로 쌓고 main은 뒤에서부터 처리 = 기존 스택 순서)
+typedef struct Emergency_list {
+    Plane *planes; // 긴급 비행기 정보 복사본
+    int size;
+    int cap;
+} EmergencyList;
+
+// worker별 통계 (자주 갱신되므로 별도 캐시 라인)
+typedef struct Shard_stats {
+    _Alignas(CACHE_LINE_SIZE) long scanned; // 검사한 비행기 수
+    long emerg_found;                       // 발견한 긴급 비행기 수
+} ShardStats;
+
+// 스레드 할당 자원 (착륙 큐 1개 + worker 전용 자원)
+// 캐시 라인 정렬 + 패딩으로 worker마다 자기 라인만 쓰도록 분리
+typedef struct Queue_shard {
+    _Alignas(CACHE_LINE_SIZE) SoaQueue q; // 담당 착륙 큐
+    double busy_time;                     // 이번 tick에 실제 연산한 시간 (dispatch overhead 계산용)
+    EmergencyList emerg;                  // worker 전용 긴급 리스트 (공유 쓰기 없음)
+    ShardStats stats;                     // 통계 (다음 캐시 라인)
+} QueueShard;
+
+// 상주 스레드 풀 (매 tick마다 pthread_create/join 하지 않음)
+// start_barrier에서 대기하다가 main이 풀어주면 자기 큐를 처리하고 done_barrier에서 합류
+typedef struct Worker_pool {
+    pthread_t tid[LANDING_Q_COUNT];  // thread id (worker i는 착륙 큐 샤드 i 담당)
+    pthread_barrier_t start_barrier; // main + worker: tick 시작 신호
+    pthread_barrier_t done_barrier;  // main + worker: tick 종료 합류
+    volatile int quit;               // 1이면 worker 종료
+} WorkerPool;
+
+//// 스레드 공유 자원
+Node pool[MAX_PLANE_COUNT]; // malloc의 연산 부하 해결 (이륙 비행기만 사용)
+Node *freed_head = pool;    // 해제된 리스트의 헤드(가용 가능한 청크)
+// pthread_mutex_t poolMutex = PTHREAD_MUTEX_INITIALIZER;
+
+QueueShard landingQ[LANDING_Q_COUNT]; // 착륙 큐 (worker별 샤드)
+Queue takeoffQ[TAKEOFF_Q_COUNT]; // 이륙 큐
+EmergencyList emergL; // worker 긴급 리스트를 큐 순서대로 병합한 결과
+WorkerPool workers;
+////
+
+//@ 매 시간 단위마다 집계하기 위한 변수
+int g_total_emergency_plane_count = 0; //* 긴급 착륙을 시행한 모든 비행기의 수와 비율
+int g_total_plane_count = 0;           //* 생성 비행기 수
+int g_total_crashed_plane_count = 0;   //* 사고 당한 모든 비행기의 수와 비율
+
+int g_total_landed_count = 0;
+
+// next를 다음 주소와 연결해주는 작업 (리스트의 장점: 삭제 연산)
+void init_pool(void) {
+    // 마지막 idx직전까지 연결, next는 포인터: 주소를 연결
+    for (int i = 0; i < MAX_PLANE_COUNT - 1; i++) {
+        pool[i].next = &pool[i + 1];
+    }
+    // 마지막 idx는 next가 NULL이어야 함.
+    pool[MAX_PLANE_COUNT - 1].next = NULL;
+}
+
+// LIFO 구조 노드 반환
+Node *alloc_node(void) {
+    // 가용 가능한 청크가 없는 경우(다 씀)
+    if (freed_head == NULL) {
+        printf("freed_head is NULL (FULL MEMORY)\n");
+        return NULL;
+    }
+
+    // 하나씩 가져가며 pool은 줄어듦.
+    Node *newNode = freed_head;
+    freed_head = freed_head->next;
+
+    // 배열에서 떼어내 연결리스트로 사용할 것이기 때문에 기존 연결을 끊어줘야 함.
+    newNode->next = NULL;
+    return newNode;
+}
+
+// LIFO 구조 노드 해제 및 재사용을 위한 연결
+void free_node(Node *temp) {
+    // 해제된 청크를 다시 사용 (LIFO)
+    temp->next = freed_head;
+    freed_head = temp;
+}
+
+// FIFO 구조 큐 초기화
+void init_queue(Queue *queue) {
+    queue->head = NULL;
+    queue->tail = NULL;
+    queue->size = 0;
+}
+
+// FIFO 구조 큐 삽입
+void enqueue(Queue *queue, Node *temp) {
+    if (queue->tail == NULL) {
+        // tail에 아무것도 없는 경우
+        queue->head = temp; //head 조정
+        queue->tail = temp;
+        queue->size++;
+        return;
+    }
+    temp->next = NULL; // 기존 연결이 있을 수 있으니 해제
+    queue->tail->next = temp;
+    queue->tail = temp;
+    queue->size++;
+}
+
+// FIFO 구조 큐 삭제
+Node *dequeue(Queue *queue) {
+    if (queue->head == NULL)
+        return NULL; // head에 아무것도 없는 경우
+
+    Node *node = queue->head;
+    queue->head = queue->head->next;
+
+    if (queue->head == NULL)
+        queue->tail = NULL; // tail 조정
+    queue->size--;
+
+    return node;
+}
+
+// 착륙 큐 배열 초기화
+void init_soa_queue(SoaQueue *q) {
+    q->fuel = malloc(SOA_INIT_CAP * sizeof(int8_t));
+    q->consume = malloc(SOA_INIT_CAP * sizeof(int8_t));
+    q->idx = malloc(SOA_INIT_CAP * sizeof(uint32_t));
+    q->entryTime = malloc(SOA_INIT_CAP * sizeof(int32_t));
+    if (!q->fuel || !q->consume || !q->idx || !q->entryTime) {
+        printf("soa queue malloc failed (FULL MEMORY)\n");
+        exit(-1);
+    }
+    q->head = 0;
+    q->tail = 0;
+    q->cap = SOA_INIT_CAP;
+    q->size = 0;
+}
+
+// realloc 실패 시 기존 버퍼를 잃지 않도록 임시 포인터로 받음 (실패하면 종료)
+void *soa_realloc(void *p, size_t bytes) {
+    void *grown = realloc(p, bytes);
+    if (grown == NULL) {
+        printf("soa realloc failed (FULL MEMORY)\n");
+        exit(-1);
+    }
+    return grown;
+}
+
+// 배열 끝에 자리가 없을 때: 앞쪽 빈 공간이 절반 이상이면 당기고, 아니면 2배 확장
+void soa_make_room(SoaQueue *q) {
+    if (q->head >= q->cap / 2) {
+        memmove(q->fuel, q->fuel + q->head, q->size * sizeof(int8_t));
+        memmove(q->consume, q->consume + q->head, q->size * sizeof(int8_t));
+        memmove(q->idx, q->idx + q->head, q->size * sizeof(uint32_t));
+        memmove(q->entryTime, q->entryTime + q->head, q->size * sizeof(int32_t));
+        q->head = 0;
+        q->tail = q->size;
+        return;
+    }
+    q->cap *= 2;
+    q->fuel = soa_realloc(q->fuel, q->cap * sizeof(int8_t));
+    q->consume = soa_realloc(q->consume, q->cap * sizeof(int8_t));
+    q->idx = soa_realloc(q->idx, q->cap * sizeof(uint32_t));
+    q->entryTime = soa_realloc(q->entryTime, q->cap * sizeof(int32_t));
+}
+
+// FIFO 구조 착륙 큐 삽입 (배열 끝)
+void soa_enqueue(SoaQueue *q, uint32_t idx, int fuel, int consume, int entryTime) {
+    if (q->tail == q->cap)
+        soa_make_room(q);
+
+    q->fuel[q->tail] = (int8_t)fuel;
+    q->consume[q->tail] = (int8_t)consume;
+    q->idx[q->tail] = idx;
+    q->entryTime[q->tail] = entryTime;
+    q->tail++;
+    q->size++;
+}
+
+// FIFO 구조 착륙 큐 삭제 (배열 앞): pool 노드가 아니므로 out에 복사해서 반환
+Node *soa_dequeue(SoaQueue *q, Node *out) {
+    if (q->size == 0)
+        return NULL; // 비어있는 경우
+
+    int h = q->head;
+    out->plane.idx = q->idx[h];
+    out->plane.fuel = q->fuel[h];
+    out->plane.entryTime = q->entryTime[h];
+    out->plane.consume = q->consume[h];
+    out->plane.type = 0; // 착륙: 0
+    out->next = NULL;
+
+    q->head++;
+    q->size--;
+    if (q->size == 0) {
+        q->head = 0; // 비었으면 앞으로 되감기 (memmove 없이 공간 재사용)
+        q->tail = 0;
+    }
+    return out;
+}
+
+// 긴급 리스트 초기화
+void init_emergency_list(EmergencyList *l) {
+    l->planes = malloc(SOA_INIT_CAP * sizeof(Plane));
+    if (l->planes == NULL) {
+        printf("emergency list malloc failed (FULL MEMORY)\n");
+        exit(-1);
+    }
+    l->size = 0;
+    l->cap = SOA_INIT_CAP;
+}
+
+// 긴급 리스트 끝에 추가
+void push_emergency(EmergencyList *l, Plane *emerg) {
+    if (l->size == l->cap) {
+        l->cap *= 2;
+        l->planes = soa_realloc(l->planes, l->cap * sizeof(Plane));
+    }
+    l->planes[l->size++] = *emerg;
+}
+
+// 가장 짧은 큐의 인덱스 반환 (비행기 생성 시 사용)
+int get_shortest_queue_idx(Queue *q_addr, int q_size) {
+    int min_q_idx = -1;
+    int min_q_size = 1000000000;
+    for (int i = 0; i < q_size; i++) {
+        if (q_addr[i].size < min_q_size) {
+            min_q_size = q_addr[i].size;
+            min_q_idx = i;
+        }
+    }
+    return min_q_idx;
+}
+
+// 가장 짧은 착륙 큐 샤드의 인덱스 반환 (샤드는 캐시 라인 단위라 Queue 배열로 넘길 수 없음)
+int get_shortest_shard_idx(QueueShard *s_addr, int s_size) {
+    int min_q_idx = -1;
+    int min_q_size = 1000000000;
+    for (int i = 0; i < s_size; i++) {
+        if (s_addr[i].q.size < min_q_size) {
+            min_q_size = s_addr[i].q.size;
+            min_q_idx = i;
+        }
+    }
+    return min_q_idx;
+}
+
+// 이/착륙 비행기 생성 및 큐 삽입 & 생성 비행기 수 집계
+int generate_planes(int entryTime) {
+    static int land_idx = 2; // 착륙: 짝수 정수
+    static int take_idx = 1; // 이륙: 홀수 정수
+
+    // 난수는 multi_thread와 같은 스트림 (SWpj3_rng.h) >> 같은 --seed면 변형끼리 출력 diff 가능
+    Rng arrival = rng_stream(RNG_ARRIVAL, entryTime, 0);    // sub 0: 균등 도착 수 (이/착륙 공용)
+    int land_planes_cnt = rng_range(rng_next(&arrival), 6); // 0~5
+    int take_planes_cnt = rng_range(rng_next(&arrival), 6);
+
+    g_total_plane_count += (land_planes_cnt + take_planes_cnt); // 생성 비행기 수 집계
+
+    int landingQ_idx = get_shortest_shard_idx(landingQ, LANDING_Q_COUNT); // 짧은 큐 한 번 구해서 그냥 다 넣기 (비행기 수 적을 때)
+    int takeoffQ_idx = get_shortest_queue_idx(takeoffQ, TAKEOFF_Q_COUNT);
+
+    // 착륙 비행기 정보 기입
+    for (int i = 0; i < land_planes_cnt; i++) {
+        // 착륙 비행기는 pool 노드 없이 배열에 바로 기입
+        uint32_t r[4];
+        rng_block(RNG_LANDING_PLANE, entryTime, 0, i, r); // 비행기마다 블록 1개 (tick 내 순번 i)
+        int fuel = rng_range(r[0], 49) + 20;  // 20~68
+        int consume = rng_range(r[1], 3) + 3; // 1~3: 0이 되면 안됨
+
+        // int landingQ_idx = get_shortest_queue_idx(landingQ, LANDING_Q_COUNT); // 연산 수 증가
+        soa_enqueue(&landingQ[landingQ_idx].q, land_idx, fuel, consume, entryTime); // 착륙 큐 삽입
+        land_idx += 2;
+    }
+    //이륙 비행기 정보 기입
+    for (int i = 0; i < take_planes_cnt; i++) {
+        Node *newNode = alloc_node();
+        newNode->plane.idx = take_idx;
+        newNode->plane.entryTime = entryTime;
+        newNode->plane.type = 1; //이륙: 1
+
+        // int takeoffQ_idx = get_shortest_queue_idx(takeoffQ, TAKEOFF_Q_COUNT); // 연산 수 증가
+        take_idx += 2;
+
+        enqueue(&takeoffQ[takeoffQ_idx], newNode); // 이륙 큐 삽입
+    }
+}
+
+//// 연료 감소 커널
+// [r, r+n) 구간의 (이미 감소된) 연료를 보고 생존 비행기는 w로 당겨 쓰고, dead 비트인 비행기는 긴급 리스트로
+// 반환값: 다음 쓸 위치 w
+int compact_lanes(SoaQueue *q, EmergencyList *emerg, int r, int n, uint32_t dead, int w) {
+    for (int k = 0; k < n; k++, r++) {
+        if (dead & (1u << k)) {
+            Plane emergency = {q->idx[r], q->fuel[r], q->entryTime[r], q->consume[r], 0};
+            push_emergency(emerg, &emergency);
+            continue;
+        }
+        if (w != r) {
+            q->fuel[w] = q->fuel[r];
+            q->consume[w] = q->consume[r];
+            q->idx[w] = q->idx[r];
+            q->entryTime[w] = q->entryTime[r];
+        }
+        w++;
+    }
+    return w;
+}
+
+// 앞에서부터 한 번 훑으며 연료 감소 + 생존 비행기는 앞으로 당겨 씀 (FIFO 순서 유지)
+// 반환값: 새 tail
+int fuel_scan_scalar(SoaQueue *q, EmergencyList *emerg, int r) {
+    int8_t *fuel = q->fuel;
+    int8_t *consume = q->consume;
+    uint32_t *idx = q->idx;
+    int32_t *entryTime = q->entryTime;
+
+    int w = r; // 생존 비행기를 쓸 위치
+    for (; r < q->tail; r++) {
+        int8_t f = fuel[r] - consume[r];
+
+        //연료가 부족한 경우: 긴급 리스트로 복사 후 배열에서 제외
+        if (f <= 0) {
+            Plane emergency = {idx[r], f, entryTime[r], consume[r], 0};
+            push_emergency(emerg, &emergency);
+            continue;
+        }
+        // 앞에 빠진 비행기가 있으면 당겨 씀
+        if (w != r) {
+            consume[w] = consume[r];
+            idx[w] = idx[r];
+            entryTime[w] = entryTime[r];
+        }
+        fuel[w] = f;
+        w++;
+    }
+    return w;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// 블록 전체가 생존했지만 앞에 빈 자리가 있는 경우: 블록을 통째로 w로 이동
+void move_block(SoaQueue *q, int w, int r, int n) {
+    memmove(q->fuel + w, q->fuel + r, n * sizeof(int8_t));
+    memmove(q->consume + w, q->consume + r, n * sizeof(int8_t));
+    memmove(q->idx + w, q->idx + r, n * sizeof(uint32_t));
+    memmove(q->entryTime + w, q->entryTime + r, n * sizeof(int32_t));
+}
+
+// SSE2: int8_t 16대씩 감소 + (연료 < 1) 마스크
+__attribute__((target("sse2"))) int fuel_scan_sse2(SoaQueue *q, EmergencyList *emerg, int r) {
+    const __m128i one = _mm_set1_epi8(1);
+    int w = r;
+
+    for (; r + 16 <= q->tail; r += 16) {
+        __m128i f = _mm_loadu_si128((__m128i *)(q->fuel + r));
+        __m128i c = _mm_loadu_si128((__m128i *)(q->consume + r));
+        f = _mm_sub_epi8(f, c);
+        _mm_storeu_si128((__m128i *)(q->fuel + r), f);
+        uint32_t dead = (uint32_t)_mm_movemask_epi8(_mm_cmpgt_epi8(one, f));
+
+        if (dead == 0) {
+            if (w != r)
+                move_block(q, w, r, 16);
+            w += 16;
+            continue;
+        }
+        w = compact_lanes(q, emerg, r, 16, dead, w);
+    }
+    // 16대 미만 나머지는 scalar로 처리 후 결과를 w 뒤에 이어 붙임
+    int rest_start = r;
+    int rest_end = fuel_scan_scalar(q, emerg, r);
+    if (w != rest_start)
+        move_block(q, w, rest_start, rest_end - rest_start);
+    return w + (rest_end - rest_start);
+}
+
+// AVX2: int8_t 32대씩 감소 + (연료 < 1) 마스크
+__attribute__((target("avx2"))) int fuel_scan_avx2(SoaQueue *q, EmergencyList *emerg, int r) {
+    const __m256i one = _mm256_set1_epi8(1);
+    int w = r;
+
+    for (; r + 32 <= q->tail; r += 32) {
+        __m256i f = _mm256_loadu_si256((__m256i *)(q->fuel + r));
+        __m256i c = _mm256_loadu_si256((__m256i *)(q->consume + r));
+        f = _mm256_sub_epi8(f, c);
+        _mm256_storeu_si256((__m256i *)(q->fuel + r), f);
+        uint32_t dead = (uint32_t)_mm256_movemask_epi8(_mm256_cmpgt_epi8(one, f));
+
+        if (dead == 0) {
+            if (w != r)
+                move_block(q, w, r, 32);
+            w += 32;
+            continue;
+        }
+        w = compact_lanes(q, emerg, r, 32, dead, w);
+    }
+    // 32대 미만 나머지는 scalar로 처리 후 결과를 w 뒤에 이어 붙임
+    int rest_start = r;
+    int rest_end = fuel_scan_scalar(q, emerg, r);
+    if (w != rest_start)
+        move_block(q, w, rest_start, rest_end - rest_start);
+    return w + (rest_end - rest_start);
+}
+#endif
+
+// 실행 중 CPU에 맞는 커널 (main 시작 시 1번 선택)
+int (*fuel_scan_kernel)(SoaQueue *, EmergencyList *, int) = fuel_scan_scalar;
+const char *fuel_scan_kernel_name = "scalar";
+
+void select_fuel_scan_kernel(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    if (FORCE_SCALAR_SCAN)
+        return;
+    __builtin_cpu_init(); // CPUID
+    if (__builtin_cpu_supports("avx2")) {
+        fuel_scan_kernel = fuel_scan_avx2;
+        fuel_scan_kernel_name = "avx2";
+    }
+    else if (__builtin_cpu_supports("sse2")) {
+        fuel_scan_kernel = fuel_scan_sse2;
+        fuel_scan_kernel_name = "sse2";
+    }
+#endif
+}
+
+//// 단일 스레드의 무거운 연산 수행 (multi_thread와 같은 작업량: 배치 비교 시 조건 동일)
+void heavy_task(void) {
+    double result = 0.0;
+
+    for (int i = 0; i < 50000; i++) {
+        result += (i * 3.141592) / 1.001;
+    }
+}
+
+//// 스레드 함수 (go_..)
+// 연료 감소 및 <0 도달 감지 + 긴급 리스트 연결 수행
+void *go_fuel_dec_and_check(void *arg) {
+    QueueShard *src = (QueueShard *)arg; // 스레드 인자 형변환
+    SoaQueue *q = &src->q;               // 스레드가 들고온 도착 큐
+
+    for (int i = 0; i < 100; i++) {
+        heavy_task();
+    }
+
+    int w = fuel_scan_kernel(q, &src->emerg, q->head);
+
+    src->stats.scanned += q->size;
+    src->stats.emerg_found += q->tail - w;
+    q->tail = w;
+    q->size = w - q->head;
+    return NULL;
+}
+
+// 벽시계 시간(sec) 반환 (clock()은 모든 스레드의 CPU 시간을 합산하므로 멀티 스레드 비교에 부적합)
+double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+//// 상주 worker 함수
+// tick마다 start_barrier에서 깨어나 자기 큐만 처리하고 done_barrier에서 합류
+void *go_worker(void *arg) {
+    QueueShard *src = (QueueShard *)arg;
+
+    while (1) {
+        pthread_barrier_wait(&workers.start_barrier); // main의 tick 시작 신호 대기
+        if (workers.quit)
+            break; // 종료 신호
+
+        double start = now_sec();
+        go_fuel_dec_and_check(src);
+        src->busy_time = now_sec() - start;
+
+        pthread_barrier_wait(&workers.done_barrier); // main에게 처리 완료 알림
+    }
+    return NULL;
+}
+
+// 스레드 풀 생성 (시뮬레이션 시작 시 1번만)
+int init_worker_pool(void) {
+    workers.quit = 0;
+    // 참여자: worker LANDING_Q_COUNT개 + main 1개
+    pthread_barrier_init(&workers.start_barrier, NULL, LANDING_Q_COUNT + 1);
+    pthread_barrier_init(&workers.done_barrier, NULL, LANDING_Q_COUNT + 1);
+
+    for (int i = 0; i < LANDING_Q_COUNT; i++) {
+        // worker i는 항상 착륙 큐 샤드 i 담당
+        if (pthread_create(&workers.tid[i], NULL, go_worker, &landingQ[i])) {
+            printf("pthread_create failed.\n");
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// 한 tick의 연료 감소 수행: worker를 깨우고 모두 끝날 때까지 대기
+// 반환값: 가장 오래 걸린 worker의 연산 시간 (dispatch overhead 계산용)
+double run_worker_pool(void) {
+    pthread_barrier_wait(&workers.start_barrier); // worker 출발
+    pthread_barrier_wait(&workers.done_barrier);  // worker 전원 합류
+
+    // 큐 idx 순서대로 worker 긴급 리스트 병합
+    // >> 단일 스레드에서 큐 0번부터 push한 것과 같은 순서 (스레드 타이밍과 무관)
+    double max_busy = 0.0;
+    for (int i = 0; i < LANDING_Q_COUNT; i++) {
+        QueueShard *a = &landingQ[i];
+        if (a->busy_time > max_busy)
+            max_busy = a->busy_time;
+
+        for (int k = 0; k < a->emerg.size; k++)
+            push_emergency(&emergL, &a->emerg.planes[k]);
+        a->emerg.size = 0; // 다음 tick을 위한 초기화
+    }
+    return max_busy;
+}
+
+// 스레드 풀 종료 (시뮬레이션 종료 시 1번만)
+int destroy_worker_pool(void) {
+    workers.quit = 1;
+    pthread_barrier_wait(&workers.start_barrier); // quit 확인하도록 깨움
+
+    for (int j = 0; j < LANDING_Q_COUNT; j++) {
+        if (pthread_join(workers.tid[j], NULL)) {
+            printf("pthread_join failed\n");
+            return -1;
+        }
+    }
+    pthread_barrier_destroy(&workers.start_barrier);
+    pthread_barrier_destroy(&workers.done_barrier);
+    return 0;
+}
+
+// 잔여 활주로 수 반환: >0, 0
+int is_there_remain_runway(int *rw_used) {
+    int remainRW = 0;
+    for (int i = 0; i < RUNWAY_COUNT; i++) {
+        // 점유된 활주로가 있다면
+        if (rw_used[i] == 1)
+            continue;
+        else
+            remainRW++;
+    }
+    return remainRW;
+}
+
+// 각 역할 큐 전체 사이즈 참조 비교 (call by ref: 배열 반환이 안되네..)
+void get_total_queue_size(QueueShard *landQ, Queue *takeQ,
+                          int *l_total_landing_queue_size, int *l_total_takeoff_queue_size) {
+    for (int i = 0; i < LANDING_Q_COUNT; i++)
+        *l_total_landing_queue_size += landQ[i].q.size;
+    for (int i = 0; i < TAKEOFF_Q_COUNT; i++)
+        *l_total_takeoff_queue_size += takeQ[i].size;
+}
+
+// 가장 긴 큐의 인덱스 반환 (이륙 시 사용)
+int get_longest_queue_idx(Queue *q_addr, int q_size) {
+    int max_q_idx = -1;
+    int max_q_size = -1;
+    for (int i = 0; i < q_size; i++) {
+        if (q_addr[i].size > max_q_size) {
+            max_q_idx = i;
+            max_q_size = q_addr[i].size;
+        }
+    }
+    return max_q_idx;
+}
+
+// 가장 긴 착륙 큐 샤드의 인덱스 반환 (착륙 시 사용)
+int get_longest_shard_idx(QueueShard *s_addr, int s_size) {
+    int max_q_idx = -1;
+    int max_q_size = -1;
+    for (int i = 0; i < s_size; i++) {
+        if (s_addr[i].q.size > max_q_size) {
+            max_q_idx = i;
+            max_q_size = s_addr[i].q.size;
+        }
+    }
+    return max_q_idx;
+}
+
+/////////////////// main
+int main(int argc, char **argv) {
+    // 프로그램 시작하자마자 버퍼링 끄기
+    setbuf(stdout, NULL);
+
+    // 옵션: --seed N, --replication N (multi_thread와 같은 seed면 같은 비행기 생성)
+    if (rng_parse_args(argc, argv))
+        return -1;
+    // 풀 초기화
+    init_pool();
+    // 큐 초기화
+    for (int i = 0; i < LANDING_Q_COUNT; i++) {
+        init_soa_queue(&landingQ[i].q);
+        init_emergency_list(&landingQ[i].emerg);
+    }
+    for (int i = 0; i < TAKEOFF_Q_COUNT; i++)
+        init_queue(&takeoffQ[i]);
+    // 긴급 리스트 초기화
+    init_emergency_list(&emergL);
+
+    // 연료 감소 커널 선택 (CPUID)
+    select_fuel_scan_kernel();
+
+    // 스레드 풀 생성 (1번만)
+    if (init_worker_pool())
+        return -1;
+
+    //// 멀티 스레드 소요시간 파악
+    double l_total_time = 0.0;     // 연료 감소 단계 전체 시간
+    double l_total_dispatch = 0.0; // 그 중 worker 깨우기/합류에 쓴 시간
+
+    //// simulation run
+    // 틱 마다 한 작업만 수행 (활주로 마다)
+    for (int tick = 1; tick <= SIMULATION_DONE; tick++) {
+        printf("%d---------------------One loop start------------------------\n", tick);
+
+        int l_total_landing_latency = 0;     // 평균 착륙 대기시간 집계용
+        int l_total_landing_plane_count = 0; // 평균 착륙 대기시간 집계용
+
+        int l_total_takeoff_latency = 0;     // 평균 이륙 대기시간 집계용
+        int l_total_takeoff_plane_count = 0; // 평균 이륙 대기시간 집계용
+
+        int l_total_landing_remaining = 0; // 평균 남은 제한 시간 집계용
+
+        generate_planes(tick); // 0~3대 비행기 이/착륙 큐 삽입, tick: entryTime
+
+        int rw_used[RUNWAY_COUNT] = {0}; // 활주로 초기화 & used: 1
+
+        //todo============================
+        // 상주 worker를 깨워서 수행 (tick마다 스레드 생성X)
+        //// 연료 감소 & <0 도달 감지 & 긴급 리스트 삽입
+        double start_time = now_sec();
+        double max_busy = run_worker_pool();
+        double end_time = now_sec();
+        l_total_time += end_time - start_time;
+        l_total_dispatch += (end_time - start_time) - max_busy; // 연산 외의 깨우기/합류 비용
+        //todo============================
+
+        // 비행기 삽입 후 연산
+        // 스레드 종료 후 연산 (긴급 리스트로 빠진 놈까지 기억 중)
+        int l_total_landing_queue_size = 0;
+        int l_total_takeoff_queue_size = 0;
+        get_total_queue_size(landingQ, takeoffQ,
+                             &l_total_landing_queue_size, &l_total_takeoff_queue_size);
+
+        //// 긴급 착륙 & 추락 한 방에 처리
+        // 해당 분기를 통과하면 비어있을 경우 X
+        if (emergL.size > 0) {
+            // 활주로 우선순위 배열 세팅 (마지막 활주로 우선)
+            int rw_priority[RUNWAY_COUNT]; // 배열: uint8_t > int 자동승격
+            for (int i = 0; i < RUNWAY_COUNT; i++)
+                rw_priority[i] = RUNWAY_COUNT - i - 1;
+
+            int survived_plane_count = 0; // 최대 3
+
+            // 뒤에서부터 처리 (기존 긴급 스택의 LIFO 순서)
+            for (int k = emergL.size - 1; k >= 0; k--) {
+                Plane *curr = &emergL.planes[k];
+                // 긴급 리스트 중 3개만 착륙
+                if (survived_plane_count < 3) { // 최대 3번 수행
+
+                    rw_used[rw_priority[survived_plane_count]] = 1; // 활주로 사용 명시
+                    g_total_emergency_plane_count++;                // 긴급 착륙한 비행기 집계
+                    l_total_landing_queue_size--;                   // 착륙했으니 감소
+
+                    printf("[!] [EMERGENCY] ID: %d, RW: %d, Fuel: %d, Type: %d\n",
+                           curr->idx, rw_priority[survived_plane_count] + 1,
+                           curr->fuel, curr->type);
+                    survived_plane_count++; //! 출력에서 survived.. 를 사용하기 때문에 출력 후 증가
+                }
+                // 긴급 스택이 3개 이상인 경우: 나머지 다 추락
+                else {
+                    // 추락한 비행기 집계
+                    g_total_crashed_plane_count++;
+                    l_total_landing_queue_size--; //추락했으니 감소
+                    printf("[X] [CRASHED] ID: %d, Fuel: %d\n", curr->idx, curr->fuel);
+                }
+            }
+            emergL.size = 0; // 다음 tick을 위한 초기화
+        }
+        else {
+            printf("Emerency Stack is empty.\n");
+        }
+
+        //// 일반 착륙 & 이륙 중 큐 길이가 긴 것 우선 처리
+        //? 활주로 개수만큼 큐 길이 확인 후 이/착륙 수행 비효율 > 한 번 확인 후 같은 동작 수행이 효율적일 듯 (활주로 적을 때 유효)
+        // 잔여 활주로가 있다면
+        int remainRW_count; // 잔여 활주로 수
+        if (remainRW_count = is_there_remain_runway(rw_used)) {
+
+            // 빈 활주로 위치 파악
+            int remainRW_idx[remainRW_count];
+            // 빈 활주로 idx 파악
+            int idx = 0;
+            for (int j = 0; j < RUNWAY_COUNT; j++) {
+                if (rw_used[j] == 1)
+                    continue;
+                remainRW_idx[idx++] = j;
+            }
+
+            // 착륙: 1, 이륙: 0 (우선순위 편향을 위함)
+            int bias_mode = (l_total_landing_queue_size > l_total_takeoff_queue_size) ? 1 : 0;
+            Node *target = NULL;
+            Node landed; // 착륙 비행기는 pool 노드가 아니므로 복사해서 사용
+
+            // mode를 통해 우선순위를 두고 매번 긴 큐 탐색
+            for (int i = 0; i < remainRW_count; i++) {
+
+                int mode = bias_mode; // 편향 덮어쓰기 방지
+
+                // 활주로가 이륙 전용이면 바로 이륙 프로세스 수행
+                if (remainRW_idx[i] == TAKEOFF_ONLY) {
+                    mode = 0; // 얘가 mode를 바꿔줘야 하기 때문에 bias_mode 복사 사용
+                    int takeoffQ_idx = get_longest_queue_idx(takeoffQ, TAKEOFF_Q_COUNT);
+                    target = dequeue(&takeoffQ[takeoffQ_idx]);
+                    if (target == NULL) {
+                        printf("Takeoff is empty.\n");
+                        continue; // 해당 활주로는 이제 쓸 일 없으므로 스킵
+                    }
+                }
+                // 활주로가 범용이면 이/착륙 중 모드 우선 처리 (해당 큐를 모두 사용하면 다음 큐)
+                else {
+                    // 착륙 모드면
+                    if (mode) {
+                        // 매 루프마다 가장 긴 큐를 탐색 (해당 mode의 큐를 모두 소모)
+                        int landingQ_idx = get_longest_shard_idx(landingQ, LANDING_Q_COUNT);
+                        target = soa_dequeue(&landingQ[landingQ_idx].q, &landed);
+                        // 해당 mode의 모든 큐를 소모했으면 bias_mode 변경
+                        if (target == NULL) {
+                            printf("[?] Throw to TAKEOFF.\n");
+                            // 갱신 (target을 설정해서 전달할거임)
+                            int takeoffQ_idx = get_longest_queue_idx(takeoffQ, TAKEOFF_Q_COUNT);
+                            target = dequeue(&takeoffQ[takeoffQ_idx]);
+                            bias_mode = 0; // 편향 변경
+                            mode = bias_mode;
+                        }
+                    }
+                    // 이륙 모드면
+                    else {
+                        int takeoffQ_idx = get_longest_queue_idx(takeoffQ, TAKEOFF_Q_COUNT);
+                        target = dequeue(&takeoffQ[takeoffQ_idx]);
+                        // 해당 mode의 모든 큐를 소모했으면 bias_mode 변경
+                        if (target == NULL) {
+                            printf("[?] Throw to LANDING.\n");
+                            // 갱신 (target을 설정해서 전달할거임)
+                            int landingQ_idx = get_longest_shard_idx(landingQ, LANDING_Q_COUNT);
+                            target = soa_dequeue(&landingQ[landingQ_idx].q, &landed);
+                            bias_mode = 1; // 편향 변경
+                            mode = bias_mode;
+                        }
+                    }
+                }
+
+                // mode에 대한 적절한 처리
+                // 착륙의 경우
+                //! 이/착륙 큐가 모두 빈 경우: target == NULL인 경우 발생
+                //! 이륙 전용 활주로의 경우: target == NULL인 경우 발생
+                if (target != NULL) {
+                    if (mode) {
+                        l_total_landing_remaining += (target->plane.fuel / target->plane.consume); // 남은 제한시간 집계
+                        l_total_landing_latency += (tick - target->plane.entryTime);               // 착륙 대기 시간 집계
+                        l_total_landing_queue_size--;                                              // 착륙했으니 감소
+                        l_total_landing_plane_count++;                                             // 착륙했으니 증가
+                        g_total_landed_count++;
+
+                        printf("[*] [LANDING] ID: %d, RW: %d, Fuel: %d, Type: %d\n",
+                               target->plane.idx, remainRW_idx[i] + 1,
+                               target->plane.fuel, target->plane.type);
+                    }
+                    // 이륙의 경우
+                    else {
+                        l_total_takeoff_latency += (tick - target->plane.entryTime); // 이륙 대기 시간 집계
+                        l_total_takeoff_queue_size--;                                // 이륙했으니 감소
+                        l_total_takeoff_plane_count++;                               // 이륙했으니 증가
+
+                        printf("[*] [TAKEOFF] ID: %d, RW: %d, Type: %d\n",
+                               target->plane.idx, remainRW_idx[i] + 1, target->plane.type);
+                    }
+                    // 공통작업이라 뺌
+                    rw_used[remainRW_idx[i]] = 1;
+                    if (target != &landed)
+                        free_node(target); // 이륙 비행기만 pool 반환
+                }
+                else {
+                    printf("Takeoff, Landing is all empty.\n");
+                }
+            }
+        } // 한 단위 종료
+
+        printf("-----------------------One loop done------------------------\n");
+        // 평균 이륙 지연시간, 평균 착륙 지연시간
+        if (l_total_takeoff_plane_count == 0) {
+            printf("In this loop TAKEOFF none.\n");
+        }
+        else {
+            printf("[+] [Avg Takeoff Latency] %d\n",
+                   l_total_takeoff_latency / l_total_takeoff_plane_count);
+        }
+
+        // 평균 착륙
+        if (l_total_landing_plane_count == 0) {
+            printf("In this loop LANDING none.\n");
+        }
+        else {
+            printf("[+] [Avg Landing Latentcy] %d\n",
+                   l_total_landing_latency / l_total_landing_plane_count);
+            printf("[+] [Avg Remaining Time Limit] %d\n",
+                   l_total_landing_remaining / l_total_landing_plane_count);
+        }
+
+        // 활주로 점유 상태
+        printf("[+] [Runway Status] [");
+        for (int i = 0; i < RUNWAY_COUNT; i++) {
+            if (i == RUNWAY_COUNT - 1) {
+                printf(" %d", rw_used[i]);
+                break;
+            }
+            printf(" %d, ", rw_used[i]);
+        }
+        printf(" ]\n");
+
+        // 큐 상태
+        printf("[+] [Total Landing Queue Size] %d\n", l_total_landing_queue_size);
+        printf("[+] [Total Takeoff Queue Size] %d\n", l_total_takeoff_queue_size);
+        printf("\n[&] landed: %d, takeoff: %d, total: %d\n\n", g_total_landed_count,
+               l_total_takeoff_plane_count, g_total_plane_count);
+
+    } // 시뮬레이션 종료
+
+    printf("\n\n=============[ Simulation is done! Let's check it out! ]=============\n");
+    printf("[Total Emergency Landed]: %d\n", g_total_emergency_plane_count);
+    printf("[Total Crashed Planes] %d\n", g_total_crashed_plane_count);
+    if (g_total_plane_count == 0) {
+        printf("g_total_plane_count == 0.\n");
+    }
+    else {
+        printf("[Avg Emergency Landed] %lf\n", ((double)g_total_emergency_plane_count / g_total_plane_count * 100.0));
+        printf("[Avg Crashed Planes] %lf\n ", ((double)g_total_crashed_plane_count / g_total_plane_count * 100.0));
+    }
+
+    if (destroy_worker_pool())
+        return -1;
+
+    printf("====[multi thread: SoA landing queue]====\n");
+    printf("Seed: %llu, Replication: %u\n", (unsigned long long)g_seed, g_replication);
+    printf("Avg Time: %.6f sec\n", l_total_time / SIMULATION_DONE);
+    printf("Avg Dispatch Overhead: %.9f sec\n", l_total_dispatch / SIMULATION_DONE);
+    printf("Fuel Scan Kernel: %s\n", fuel_scan_kernel_name);
+
+    long l_total_scanned = 0;
+    long l_total_found = 0;
+    for (int i = 0; i < LANDING_Q_COUNT; i++) {
+        l_total_scanned += landingQ[i].stats.scanned;
+        l_total_found += landingQ[i].stats.emerg_found;
+    }
+    printf("Scanned Planes: %ld, Emergency Found: %ld\n", l_total_scanned, l_total_found);
+}
+
+// int pthread_create(pthread_t* thread,
+// 										pthread_attr_t* attr, void* (*routine)(void*), void* arg);
+// - thread: 생성을 성공하면 그 쓰레드의 ID가 저장된다.
+// - attr: 쓰레드의 속성 객체, 기본 속성을 사용할 경우 NULL을 넣는다.
+// - routine: 스레드의 실행코드 영역
+// - arg: 스레드에게 전달할 인자를 담은 구조체의 포인터, Nullable.
+// - 반환값: 0, 0보다 작은 값
+// ------------------------------------------------------------------------------
+// void pthread_exit(void* retval)
+// - retval: 반환할 구조체의 포인터, Nullable
+// ------------------------------------------------------------------------------
+// int pthread_join(pthread_t thread, void** thread_return) : 0, 음수 에러코드
+// - thread: 기다릴 스레드ID
+// - thread_return: 반환하는 포인터가 저장되는 포인터 변수
+// ------------------------------------------------------------------------------
+// > **Lock 변수 선언 및 초기화 방법 2가지**
+// 1. 전역 변수로 선언 - **`pthread_mutex_t lock;`**
+// 2. 한 함수에서 선언 - **`pthread_mutex_init(&lock, NULL);
+// ------------------------------------------------------------------------------
+// 전역 lock 적용
+// pthread_mutex_lock(&lock);
+// for (i = 0; i < LOOP; i++){
+//   gdata += data;
+// }
+// pthread_mutex_unlock(&lock);
+
+//// 예상 문제? 큐 정렬,
\ No newline at end of file
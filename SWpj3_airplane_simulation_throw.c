@@ -1,9 +1,11 @@
 #include <pthread.h>
+#include <stdatomic.h> // 긴급 스택 pop (exchange)
 #include <stdint.h> // uint8_t를 사용하기 위해 추가 (1byte)
 #include <stdio.h>
-#include <stdlib.h> // random
 #include <time.h>
 
+#include "SWpj3_rng.h" // 난수 (Philox, --seed)
+
 #define SIMULATION_DONE 1000    // 시뮬레이션 횟수
 #define MAX_PLANE_COUNT 1000000 // 최대 공존 가능 비행기 수
 // #define LANDING_Q_COUNT 4       // 착륙 큐 개수
@@ -53,18 +55,34 @@ typedef struct Queue {
     int size;   // 로드 밸런싱
 } Queue;
 
-// 긴급 리스트 ()
+// 긴급 리스트
+// worker는 자기 버퍼에만 쌓고, main이 합류 후 버퍼를 큐 순서대로 올림 >> push는 main 하나뿐 (CAS X, 경합 X)
+// pop은 exchange 1번으로 전체를 가져감
 typedef struct Stack {
-    Node *top;            // LIFO pointer
-    int size;             // 통계?
-    pthread_mutex_t lock; // 긴급 리스트
+    _Atomic(Node *) top; // LIFO pointer
+    int size;            // 통계?
+    long push_count;     // 통계: 전체 push 수
 } EmergencyStack;
 
 // 스레드 할당 자원
 typedef struct Thread_arg {
     Queue *q;
+    double busy_time; // 이번 tick에 실제 연산한 시간 (dispatch overhead 계산용)
+    Node *emerg_top;  // worker 전용 긴급 리스트 (LIFO, 공유 쓰기 없음)
+    Node *emerg_tail; // 병합 시 O(1) 연결을 위한 가장 먼저 들어온 노드
+    int emerg_size;   // worker 전용 긴급 리스트 크기
 } Arg;
 
+// 상주 스레드 풀 (매 tick마다 pthread_create/join 하지 않음)
+// start_barrier에서 대기하다가 main이 풀어주면 자기 큐를 처리하고 done_barrier에서 합류
+typedef struct Worker_pool {
+    pthread_t tid[LANDING_Q_COUNT];  // thread id
+    Arg arg[LANDING_Q_COUNT];        // thread data
+    pthread_barrier_t start_barrier; // main + worker: tick 시작 신호
+    pthread_barrier_t done_barrier;  // main + worker: tick 종료 합류
+    volatile int quit;               // 1이면 worker 종료
+} WorkerPool;
+
 //// 스레드 공유 자원
 Node pool[MAX_PLANE_COUNT]; // malloc의 연산 부하 해결
 Node *freed_head = pool;    // 해제된 리스트의 헤드(가용 가능한 청크)
@@ -73,6 +91,7 @@ Node *freed_head = pool;    // 해제된 리스트의 헤드(가용 가능한 
 Queue landingQ[LANDING_Q_COUNT]; // 착륙 큐
 Queue takeoffQ[TAKEOFF_Q_COUNT]; // 이륙 큐
 EmergencyStack emergS;
+WorkerPool workers;
 ////
 
 //@ 매 시간 단위마다 집계하기 위한 변수
@@ -171,8 +190,10 @@ int generate_planes(int entryTime) {
     static int land_idx = 2; // 착륙: 짝수 정수
     static int take_idx = 1; // 이륙: 홀수 정수
 
-    int land_planes_cnt = rand() % 6; //0~3
-    int take_planes_cnt = rand() % 6;
+    // 난수는 multi_thread와 같은 스트림 (SWpj3_rng.h) >> 같은 --seed면 변형끼리 출력 diff 가능
+    Rng arrival = rng_stream(RNG_ARRIVAL, entryTime, 0);    // sub 0: 균등 도착 수 (이/착륙 공용)
+    int land_planes_cnt = rng_range(rng_next(&arrival), 6); // 0~5
+    int take_planes_cnt = rng_range(rng_next(&arrival), 6);
 
     g_total_plane_count += (land_planes_cnt + take_planes_cnt); // 생성 비행기 수 집계
 
@@ -181,12 +202,14 @@ int generate_planes(int entryTime) {
 
     // 착륙 비행기 정보 기입
     for (int i = 0; i < land_planes_cnt; i++) {
+        uint32_t r[4];
+        rng_block(RNG_LANDING_PLANE, entryTime, 0, i, r); // 비행기마다 블록 1개 (tick 내 순번 i)
         Node *newNode = alloc_node(); // Node 할당
         newNode->plane.idx = land_idx;
-        newNode->plane.fuel = rand() % 49 + 20;  // 20~68
-        newNode->plane.entryTime = entryTime;    // 생성 시점(통계)
-        newNode->plane.consume = rand() % 3 + 3; // 1~3: 0이 되면 안됨
-        newNode->plane.type = 0;                 // 착륙: 0
+        newNode->plane.fuel = rng_range(r[0], 49) + 20;  // 20~68
+        newNode->plane.entryTime = entryTime;            // 생성 시점(통계)
+        newNode->plane.consume = rng_range(r[1], 3) + 3; // 1~3: 0이 되면 안됨
+        newNode->plane.type = 0;                         // 착륙: 0
 
         // int landingQ_idx = get_shortest_queue_idx(landingQ, LANDING_Q_COUNT); // 연산 수 증가
         land_idx += 2;
@@ -208,36 +231,38 @@ int generate_planes(int entryTime) {
 
 // 스택 초기화
 void init_emergency_stack(EmergencyStack *s) {
-    s->top = NULL;
+    atomic_init(&s->top, NULL);
     s->size = 0;
-    pthread_mutex_init(&s->lock, NULL); // lock 초기화: NULL (default)
+    s->push_count = 0;
 }
 
-// 스택 push (lock 필요)
-void push_emergency(EmergencyStack *s, Node *emerg) {
-    pthread_mutex_lock(&s->lock); // lock
-
+// 스택 push
+// worker 버퍼 하나(top ~ tail)를 통째로 올림 (main이 합류 후 큐 순서대로 호출 >> 단일 스레드, 저장 1번)
+void push_emergency(EmergencyStack *s, Node *top, Node *tail, int count) {
     // 사실상 LIFO 구조의 연결리스트
-    emerg->next = s->top; // 긴급한 비행기끼리 연결
-    s->top = emerg;
-    s->size++;
+    tail->next = atomic_load_explicit(&s->top, memory_order_relaxed); // 긴급한 비행기끼리 연결
+    atomic_store_explicit(&s->top, top, memory_order_relaxed);
+    s->size += count;
+    s->push_count += count;
+}
 
-    pthread_mutex_unlock(&s->lock); // unlock
+// worker 전용 긴급 리스트 push (자기 것만 건드리므로 lock, CAS 필요X)
+void push_local_emergency(Arg *src, Node *emerg) {
+    emerg->next = src->emerg_top;
+    if (src->emerg_top == NULL)
+        src->emerg_tail = emerg; // 첫 노드가 병합 시 꼬리
+    src->emerg_top = emerg;
+    src->emerg_size++;
 }
 
-// 스택 전체 리스트 pop (하나씩 빼 줄 필요X -> lock 필요X)
+// 스택 전체 리스트 pop (하나씩 빼 줄 필요X -> exchange 1번)
 Node *pop_all_emergency(EmergencyStack *s) {
-
-    if (s->top == NULL)
+    // 다음 tick을 위한 초기화와 동시에 기존 리스트 획득
+    Node *emerg_head = atomic_exchange_explicit(&s->top, NULL, memory_order_acquire);
+    if (emerg_head == NULL)
         return NULL; // 긴급 착륙 비행기가 없던 경우
 
-    // EmergencyStack *emerg_all_copy = s; // 동일한 객체를 가리켜 의미X
-    Node *emerg_head = s->top;
-
-    // 다음 tick을 위한 초기화
-    s->top = NULL;
     s->size = 0;
-
     return emerg_head;
 }
 
@@ -275,8 +300,9 @@ void *go_fuel_dec_and_check(void *arg) {
             curr = curr->next; // curr 재조정 (조건 재탐색)
 
             //@ link
-            // 긴급 스택에 추가 (해당 주소의 next가 변경되므로 마지막에..)
-            push_emergency(&emergS, emergency);
+            // worker 전용 긴급 리스트에 추가 (해당 주소의 next가 변경되므로 마지막에..)
+            // 공유 스택에는 barrier 이후 main이 큐 순서대로 병합 >> 실행마다 순서 동일
+            push_local_emergency(src, emergency);
         }
         else {
             // printf("[Land: %d] QAD: %p, Fuel: %d\n", test_cnt++, q, curr->plane.fuel);
@@ -286,6 +312,94 @@ void *go_fuel_dec_and_check(void *arg) {
     }
 }
 
+// 벽시계 시간(sec) 반환 (clock()은 모든 스레드의 CPU 시간을 합산하므로 멀티 스레드 비교에 부적합)
+double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+//// 상주 worker 함수
+// tick마다 start_barrier에서 깨어나 자기 큐만 처리하고 done_barrier에서 합류
+void *go_worker(void *arg) {
+    Arg *src = (Arg *)arg;
+
+    while (1) {
+        pthread_barrier_wait(&workers.start_barrier); // main의 tick 시작 신호 대기
+        if (workers.quit)
+            break; // 종료 신호
+
+        double start = now_sec();
+        go_fuel_dec_and_check(src);
+        src->busy_time = now_sec() - start;
+
+        pthread_barrier_wait(&workers.done_barrier); // main에게 처리 완료 알림
+    }
+    return NULL;
+}
+
+// 스레드 풀 생성 (시뮬레이션 시작 시 1번만)
+int init_worker_pool(void) {
+    workers.quit = 0;
+    // 참여자: worker LANDING_Q_COUNT개 + main 1개
+    pthread_barrier_init(&workers.start_barrier, NULL, LANDING_Q_COUNT + 1);
+    pthread_barrier_init(&workers.done_barrier, NULL, LANDING_Q_COUNT + 1);
+
+    for (int i = 0; i < LANDING_Q_COUNT; i++) {
+        workers.arg[i].q = &landingQ[i]; // worker i는 항상 착륙 큐 i 담당
+        workers.arg[i].busy_time = 0.0;
+        workers.arg[i].emerg_top = NULL;
+        workers.arg[i].emerg_tail = NULL;
+        workers.arg[i].emerg_size = 0;
+
+        if (pthread_create(&workers.tid[i], NULL, go_worker, &workers.arg[i])) {
+            printf("pthread_create failed.\n");
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// 한 tick의 연료 감소 수행: worker를 깨우고 모두 끝날 때까지 대기
+// 반환값: 가장 오래 걸린 worker의 연산 시간 (dispatch overhead 계산용)
+double run_worker_pool(void) {
+    pthread_barrier_wait(&workers.start_barrier); // worker 출발
+    pthread_barrier_wait(&workers.done_barrier);  // worker 전원 합류
+
+    // 큐 idx 순서대로 worker 긴급 리스트 병합
+    // >> 단일 스레드에서 큐 0번부터 push한 것과 같은 순서 (스레드 타이밍과 무관)
+    double max_busy = 0.0;
+    for (int i = 0; i < LANDING_Q_COUNT; i++) {
+        Arg *a = &workers.arg[i];
+        if (a->busy_time > max_busy)
+            max_busy = a->busy_time;
+
+        if (a->emerg_top != NULL) {
+            push_emergency(&emergS, a->emerg_top, a->emerg_tail, a->emerg_size);
+            a->emerg_top = NULL; // 다음 tick을 위한 초기화
+            a->emerg_tail = NULL;
+            a->emerg_size = 0;
+        }
+    }
+    return max_busy;
+}
+
+// 스레드 풀 종료 (시뮬레이션 종료 시 1번만)
+int destroy_worker_pool(void) {
+    workers.quit = 1;
+    pthread_barrier_wait(&workers.start_barrier); // quit 확인하도록 깨움
+
+    for (int j = 0; j < LANDING_Q_COUNT; j++) {
+        if (pthread_join(workers.tid[j], NULL)) {
+            printf("pthread_join failed\n");
+            return -1;
+        }
+    }
+    pthread_barrier_destroy(&workers.start_barrier);
+    pthread_barrier_destroy(&workers.done_barrier);
+    return 0;
+}
+
 // 잔여 활주로 수 반환: >0, 0
 int is_there_remain_runway(int *rw_used) {
     int remainRW = 0;
@@ -322,11 +436,13 @@ int get_longest_queue_idx(Queue *q_addr, int q_size) {
 }
 
 /////////////////// main
-int main(void) {
+int main(int argc, char **argv) {
     // 프로그램 시작하자마자 버퍼링 끄기
     setbuf(stdout, NULL);
 
-    srand(time(NULL));
+    // 옵션: --seed N, --replication N (multi_thread와 같은 seed면 같은 비행기 생성)
+    if (rng_parse_args(argc, argv))
+        return -1;
     // 풀 초기화
     init_pool();
     // 큐 초기화
@@ -336,6 +452,13 @@ int main(void) {
         init_queue(&takeoffQ[i]);
     // 긴급 스택 초기화
     init_emergency_stack(&emergS);
+    // 스레드 풀 생성 (1번만)
+    if (init_worker_pool())
+        return -1;
+
+    //// 멀티 스레드 소요시간 파악
+    double l_total_time = 0.0;     // 연료 감소 단계 전체 시간
+    double l_total_dispatch = 0.0; // 그 중 worker 깨우기/합류에 쓴 시간
 
     //// simulation run
     // 틱 마다 한 작업만 수행 (활주로 마다)
@@ -354,26 +477,13 @@ int main(void) {
 
         int rw_used[RUNWAY_COUNT] = {0}; // 활주로 초기화 & used: 1
 
-        pthread_t tid[LANDING_Q_COUNT]; // thread id
-        Arg arg[LANDING_Q_COUNT];       // thread data
-
-        // thread 생성 및 정보 저장 후 수행
+        // 상주 worker를 깨워서 수행 (tick마다 스레드 생성X)
         //// 연료 감소 & <0 도달 감지 & EmergencyStack 삽입
-        for (int i = 0; i < LANDING_Q_COUNT; i++) {
-            arg[i].q = &landingQ[i];
-
-            if (pthread_create(&tid[i], NULL, go_fuel_dec_and_check, &arg[i])) {
-                printf("pthread_create failed.\n");
-                return -1;
-            }
-        }
-        // thread 종료 대기
-        for (int j = 0; j < LANDING_Q_COUNT; j++) {
-            if (pthread_join(tid[j], NULL)) { // Second arg: 반환하는 포인터가 저장되는 포인터 변수
-                printf("pthread_join failed\n");
-                return -1;
-            }
-        }
+        double start_time = now_sec();
+        double max_busy = run_worker_pool();
+        double end_time = now_sec();
+        l_total_time += end_time - start_time;
+        l_total_dispatch += (end_time - start_time) - max_busy; // 연산 외의 깨우기/합류 비용
 
         // 비행기 삽입 후 연산
         // 스레드 종료 후 연산 (긴급 리스트로 빠진 놈까지 기억 중)
@@ -584,6 +694,15 @@ int main(void) {
         printf("[Avg Emergency Landed] %lf\n", ((double)g_total_emergency_plane_count / g_total_plane_count * 100.0));
         printf("[Avg Crashed Planes] %lf\n ", ((double)g_total_crashed_plane_count / g_total_plane_count * 100.0));
     }
+
+    if (destroy_worker_pool())
+        return -1;
+
+    printf("====[multi thread]====\n");
+    printf("Seed: %llu, Replication: %u\n", (unsigned long long)g_seed, g_replication);
+    printf("Avg Time: %.6f sec\n", l_total_time / SIMULATION_DONE);
+    printf("Avg Dispatch Overhead: %.9f sec\n", l_total_dispatch / SIMULATION_DONE);
+    printf("Emergency Push: %ld\n", emergS.push_count);
 }
 
 // int pthread_create(pthread_t* thread,
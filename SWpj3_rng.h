@@ -0,0 +1,100 @@
+// 시뮬레이션 공용 난수 (counter-based: Philox4x32-10)
+//
+// rand()는 전역 상태 + glibc 내부 lock >> 재현 불가(time seed), 스레드로 나눌 수 없음
+// Philox는 (key, counter) > 난수 128bit 순수 함수: 상태 공유 없이 어느 스레드에서든 같은 값
+// key = seed, counter = [순번, tick, 종류 << 24 | sub(큐 idx 등), replication]
+// >> tick/큐/replication 마다 독립 스트림, 같은 seed면 멀티 스레드에서도 비트 단위로 재현
+// >> 모든 변형(SWpj3_airplane_simulation_*.c)이 같은 스트림을 쓰므로 같은 --seed면 변형끼리 출력 diff 가능
+#ifndef SWPJ3_RNG_H
+#define SWPJ3_RNG_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define PHILOX_M0 0xD2511F53u
+#define PHILOX_M1 0xCD9E8D57u
+#define PHILOX_W0 0x9E3779B9u // key 증가량 (황금비)
+#define PHILOX_W1 0xBB67AE85u // key 증가량 (sqrt(3)-1)
+
+// 스트림 종류 (counter[2]의 상위 8bit)
+enum { RNG_ARRIVAL, RNG_LANDING_PLANE, RNG_BENCH };
+
+static uint64_t g_seed = 0;        // --seed (기본: 현재 시각)
+static uint32_t g_replication = 0; // --replication (같은 seed에서 독립 반복)
+
+// 10 라운드, 라운드 사이마다 key 증가
+static inline void philox4x32(const uint32_t ctr[4], const uint32_t key[2], uint32_t out[4]) {
+    uint32_t c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+    uint32_t k0 = key[0], k1 = key[1];
+    for (int r = 0; r < 10; r++) {
+        uint64_t p0 = (uint64_t)PHILOX_M0 * c0;
+        uint64_t p1 = (uint64_t)PHILOX_M1 * c2;
+        c0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+        c2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+        c1 = (uint32_t)p1;
+        c3 = (uint32_t)p0;
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+// 스트림 kind/tick/sub 의 index번째 블록 (난수 4개): 순서와 상관없이 바로 계산 가능
+static inline void rng_block(int kind, uint32_t tick, uint32_t sub, uint32_t index, uint32_t out[4]) {
+    uint32_t key[2] = {(uint32_t)g_seed, (uint32_t)(g_seed >> 32)};
+    uint32_t ctr[4] = {index, tick, ((uint32_t)kind << 24) | (sub & 0xFFFFFF), g_replication};
+    philox4x32(ctr, key, out);
+}
+
+// 순차로 꺼내 쓰는 스트림 (블록 4개 단위로 미리 계산)
+typedef struct Rng {
+    int kind;
+    uint32_t tick;
+    uint32_t sub;
+    uint32_t index; // 다음 블록 번호
+    uint32_t buf[4];
+    int left;
+} Rng;
+
+static inline Rng rng_stream(int kind, uint32_t tick, uint32_t sub) {
+    Rng r = {kind, tick, sub, 0, {0}, 0};
+    return r;
+}
+
+static inline uint32_t rng_next(Rng *r) {
+    if (r->left == 0) {
+        rng_block(r->kind, r->tick, r->sub, r->index++, r->buf);
+        r->left = 4;
+    }
+    return r->buf[4 - r->left--];
+}
+
+// [0, n) (나머지 연산 대신 곱셈 상위 32bit)
+static inline uint32_t rng_range(uint32_t x, uint32_t n) {
+    return (uint32_t)(((uint64_t)x * n) >> 32);
+}
+
+// 옵션: --seed N (없으면 현재 시각), --replication N
+// 같은 seed + replication이면 출력이 그대로 재현됨
+static inline int rng_parse_args(int argc, char **argv) {
+    g_seed = (uint64_t)time(NULL);
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+            g_seed = strtoull(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "--replication") == 0 && i + 1 < argc)
+            g_replication = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else {
+            printf("usage: %s [--seed N] [--replication N]\n", argv[0]);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+#endif
@@ -0,0 +1,74 @@
+// 시뮬레이션 바이너리 트레이스 형식 (SWpj3_airplane_simulation_multi_thread.c 가 기록, SWpj3_trace_*.c 가 읽음)
+//
+// [TraceHeader] [Block] [Block] ... (little-endian, 파일 그대로 mmap 해서 사용)
+// Block = [TraceBlock] + 열(column) cols개, 열 하나 = int32_t x TRACE_COL_STRIDE(count)
+// >> 이벤트 종류별 열 단위 저장: 집계 시 필요한 열만 연속으로 훑으면 됨 (텍스트 파싱 X)
+// >> 열 시작은 16byte 정렬 (SIMD 로드 가능)
+#ifndef SWPJ3_TRACE_H
+#define SWPJ3_TRACE_H
+
+#include <stdint.h>
+
+#define TRACE_MAGIC "SWPJTRC1"
+#define TRACE_VERSION 2
+#define TRACE_BLOCK_EVENTS 8192                      // 블록 당 최대 이벤트 수 (4의 배수)
+#define TRACE_COL_STRIDE(count) (((count) + 3) & ~3) // 열 길이를 4개 단위로 맞춤 (16byte 정렬)
+
+//@ 이벤트 종류
+typedef enum TraceType {
+    TRACE_TICK,      // tick 마무리 (tick당 1개)
+    TRACE_LANDING,   // 일반 착륙
+    TRACE_TAKEOFF,   // 이륙
+    TRACE_EMERGENCY, // 긴급 착륙
+    TRACE_CRASHED,   // 추락
+    TRACE_TYPE_COUNT
+} TraceType;
+
+//@ 종류별 열 순서 (값은 전부 int32_t)
+enum { TT_TICK, TT_TOTAL_PLANES, TT_LANDING_QSIZE, TT_TAKEOFF_QSIZE, TT_COLS }; // TRACE_TICK
+enum { TL_TICK, TL_IDX, TL_QUEUE, TL_RW, TL_FUEL, TL_WAIT, TL_COLS };           // TRACE_LANDING
+enum { TO_TICK, TO_IDX, TO_QUEUE, TO_RW, TO_WAIT, TO_COLS };                    // TRACE_TAKEOFF
+enum { TE_TICK, TE_IDX, TE_RW, TE_FUEL, TE_WAIT, TE_COLS };                     // TRACE_EMERGENCY
+enum { TC_TICK, TC_IDX, TC_FUEL, TC_WAIT, TC_COLS };                            // TRACE_CRASHED
+#define TRACE_MAX_COLS TL_COLS
+
+static const int trace_cols[TRACE_TYPE_COUNT] = {TT_COLS, TL_COLS, TO_COLS, TE_COLS, TC_COLS};
+
+// RW는 출력과 같은 1부터, QUEUE는 큐 idx (0부터), WAIT = tick - entryTime
+
+// 파일 맨 앞 (설정 + 종류별 이벤트 수: 이벤트 수는 종료 시 다시 기록)
+typedef struct TraceHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size; // sizeof(TraceHeader), 첫 블록 위치
+    int32_t landing_q_count;
+    int32_t takeoff_q_count;
+    int32_t runway_count;
+    int32_t takeoff_only; // 이륙 전용 활주로 idx (0부터)
+    int32_t simulation_done;
+    uint32_t block_events;
+    uint64_t seed;
+    uint32_t replication; // --replication
+    uint32_t reserved[3]; // 헤더 크기를 16byte 배수로 (열 정렬 유지)
+    uint64_t event_count[TRACE_TYPE_COUNT]; // 0이면 비정상 종료 (블록을 직접 세야 함)
+    uint64_t block_count;
+} TraceHeader;
+
+typedef struct TraceBlock {
+    uint32_t type;   // TraceType
+    uint32_t count;  // 이벤트 수
+    uint32_t cols;   // 열 수 (trace_cols[type])
+    uint32_t stride; // 열 하나의 길이 (TRACE_COL_STRIDE(count))
+} TraceBlock;
+
+// 블록 전체 크기 (다음 블록 위치 계산용)
+static inline uint64_t trace_block_bytes(const TraceBlock *b) {
+    return sizeof(TraceBlock) + (uint64_t)b->cols * b->stride * sizeof(int32_t);
+}
+
+// 블록의 c번째 열 시작 주소
+static inline const int32_t *trace_col(const TraceBlock *b, int c) {
+    return (const int32_t *)(b + 1) + (uint64_t)c * b->stride;
+}
+
+#endif
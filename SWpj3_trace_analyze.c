@@ -0,0 +1,386 @@
+// 바이너리 트레이스 (SWpj3_trace.h) 분석: 시뮬레이션을 다시 돌리지 않고 분포/추이 계산
+// 사용법: ./trace_analyze [airplane_trace.bin] [window(tick)] [threads]
+// - 큐별, 활주로별 착륙/이륙 대기 시간 분포 (count, mean, p50, p90, p99, max)
+// - tick 구간(window)별 긴급 착륙/추락 수와 긴급:추락 비율
+//
+// 파일은 mmap, 블록 헤더만 먼저 훑어서 목록을 만든 뒤 블록 단위로 스레드에 분배
+// >> 스레드마다 자기 집계 공간을 쓰고 마지막에 한 번만 합침 (공유 쓰기 없음)
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "SWpj3_trace.h"
+
+#define DEFAULT_TRACE_PATH "airplane_trace.bin"
+#define DEFAULT_WINDOW 50 // tick 구간 크기
+#define MAX_THREADS 64
+#define HIST_BINS 16384 // 대기 시간 0 ~ HIST_BINS-1 은 1 tick 단위, 이상은 마지막 칸
+#define CHUNK 1024      // 열을 나눠 처리하는 단위 (L1에 들어가는 크기)
+
+// 분포 1개 (대기 시간 히스토그램)
+typedef struct Dist {
+    uint64_t count;
+    int64_t sum;
+    int max;
+    uint64_t *bins; // HIST_BINS
+} Dist;
+
+// 스레드별 집계 공간
+typedef struct Stats {
+    Dist *landing_q;     // [landing_q_count]
+    Dist *takeoff_q;     // [takeoff_q_count]
+    Dist *landing_rw;    // [runway_count]
+    Dist *takeoff_rw;    // [runway_count]
+    uint64_t *emerg_win; // [win_count]
+    uint64_t *crash_win; // [win_count]
+    uint64_t invalid;    // 범위를 벗어난 큐/활주로 idx
+} Stats;
+
+//// 공유 (읽기 전용 + 블록 분배용 카운터)
+const TraceHeader *g_hdr;
+const TraceBlock **g_blocks; // 블록 시작 주소 목록
+long g_block_count;
+atomic_long g_next_block; // 다음에 가져갈 블록 번호
+int g_window;
+int g_win_count;
+
+double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int init_dists(Dist *d, int n) {
+    for (int i = 0; i < n; i++) {
+        d[i].count = 0;
+        d[i].sum = 0;
+        d[i].max = 0;
+        d[i].bins = calloc(HIST_BINS, sizeof(uint64_t));
+        if (d[i].bins == NULL)
+            return -1;
+    }
+    return 0;
+}
+
+int init_stats(Stats *s) {
+    const TraceHeader *h = g_hdr;
+    s->landing_q = malloc(sizeof(Dist) * h->landing_q_count);
+    s->takeoff_q = malloc(sizeof(Dist) * h->takeoff_q_count);
+    s->landing_rw = malloc(sizeof(Dist) * h->runway_count);
+    s->takeoff_rw = malloc(sizeof(Dist) * h->runway_count);
+    s->emerg_win = calloc(g_win_count, sizeof(uint64_t));
+    s->crash_win = calloc(g_win_count, sizeof(uint64_t));
+    s->invalid = 0;
+    if (!s->landing_q || !s->takeoff_q || !s->landing_rw || !s->takeoff_rw || !s->emerg_win || !s->crash_win)
+        return -1;
+    if (init_dists(s->landing_q, h->landing_q_count) || init_dists(s->takeoff_q, h->takeoff_q_count) ||
+        init_dists(s->landing_rw, h->runway_count) || init_dists(s->takeoff_rw, h->runway_count))
+        return -1;
+    return 0;
+}
+
+//// 블록 단위 집계
+// 대기 시간 분포: CHUNK 개씩 (구간 합/최대/칸 번호 계산은 분기 없는 루프 > 자동 벡터화, 칸 증가만 scatter)
+void scan_latency(Stats *s, const int32_t *wait, const int32_t *queue, const int32_t *rw, uint32_t n,
+                  Dist *by_q, int q_count, Dist *by_rw, int rw_count) {
+    int32_t val[CHUNK]; // 음수를 0으로 자른 대기 시간 (칸/합/최대 모두 이 값 사용)
+    int32_t bin[CHUNK];
+    for (uint32_t base = 0; base < n; base += CHUNK) {
+        uint32_t len = (n - base < CHUNK) ? n - base : CHUNK;
+        const int32_t *w = wait + base;
+
+        for (uint32_t i = 0; i < len; i++) {
+            int32_t v = w[i] < 0 ? 0 : w[i];
+            val[i] = v;
+            bin[i] = v < HIST_BINS - 1 ? v : HIST_BINS - 1;
+        }
+
+        for (uint32_t i = 0; i < len; i++) {
+            int q = queue[base + i];
+            int r = rw[base + i] - 1; // 트레이스는 1부터
+            if (q < 0 || q >= q_count || r < 0 || r >= rw_count) {
+                s->invalid++;
+                continue;
+            }
+            Dist *dq = &by_q[q];
+            Dist *dr = &by_rw[r];
+            dq->bins[bin[i]]++;
+            dr->bins[bin[i]]++;
+            dq->count++;
+            dr->count++;
+            dq->sum += val[i];
+            dr->sum += val[i];
+            if (val[i] > dq->max)
+                dq->max = val[i];
+            if (val[i] > dr->max)
+                dr->max = val[i];
+        }
+    }
+}
+
+// tick 열은 기록 순서 그대로 정렬돼 있음 > 구간 경계만 이분 탐색 (구간 수만큼만 연산)
+void scan_windows(const int32_t *tick, uint32_t n, uint64_t *win) {
+    uint32_t i = 0;
+    while (i < n) {
+        int w = (tick[i] < 0 ? 0 : tick[i]) / g_window;
+        int next_tick; // 다음 구간 첫 tick
+        if (w >= g_win_count - 1) {
+            w = g_win_count - 1;
+            next_tick = INT_MAX;
+        }
+        else
+            next_tick = (w + 1) * g_window;
+
+        uint32_t lo = i + 1, hi = n;
+        while (lo < hi) {
+            uint32_t mid = lo + (hi - lo) / 2;
+            if (tick[mid] < next_tick)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        win[w] += lo - i;
+        i = lo;
+    }
+}
+
+void scan_block(Stats *s, const TraceBlock *b) {
+    const TraceHeader *h = g_hdr;
+    switch (b->type) {
+    case TRACE_LANDING:
+        scan_latency(s, trace_col(b, TL_WAIT), trace_col(b, TL_QUEUE), trace_col(b, TL_RW), b->count,
+                     s->landing_q, h->landing_q_count, s->landing_rw, h->runway_count);
+        break;
+    case TRACE_TAKEOFF:
+        scan_latency(s, trace_col(b, TO_WAIT), trace_col(b, TO_QUEUE), trace_col(b, TO_RW), b->count,
+                     s->takeoff_q, h->takeoff_q_count, s->takeoff_rw, h->runway_count);
+        break;
+    case TRACE_EMERGENCY:
+        scan_windows(trace_col(b, TE_TICK), b->count, s->emerg_win);
+        break;
+    case TRACE_CRASHED:
+        scan_windows(trace_col(b, TC_TICK), b->count, s->crash_win);
+        break;
+    default:
+        break; // tick 레코드는 여기선 안 씀
+    }
+}
+
+// 블록 번호를 하나씩 가져가며 처리 (블록 크기가 달라도 부하가 고르게 퍼짐)
+// 집계 공간은 각 스레드가 직접 할당/초기화 (0 채우기도 병렬, 메모리도 그 스레드 가까이)
+void *go_scan(void *arg) {
+    Stats *s = (Stats *)arg;
+    if (init_stats(s))
+        return NULL;
+    long k;
+    while ((k = atomic_fetch_add(&g_next_block, 1)) < g_block_count)
+        scan_block(s, g_blocks[k]);
+    return s;
+}
+
+//// 합치기 & 출력
+void merge_dists(Dist *dst, const Dist *src, int n) {
+    for (int i = 0; i < n; i++) {
+        dst[i].count += src[i].count;
+        dst[i].sum += src[i].sum;
+        if (src[i].max > dst[i].max)
+            dst[i].max = src[i].max;
+        for (int b = 0; b < HIST_BINS; b++)
+            dst[i].bins[b] += src[i].bins[b];
+    }
+}
+
+void merge_stats(Stats *dst, const Stats *src) {
+    const TraceHeader *h = g_hdr;
+    merge_dists(dst->landing_q, src->landing_q, h->landing_q_count);
+    merge_dists(dst->takeoff_q, src->takeoff_q, h->takeoff_q_count);
+    merge_dists(dst->landing_rw, src->landing_rw, h->runway_count);
+    merge_dists(dst->takeoff_rw, src->takeoff_rw, h->runway_count);
+    for (int w = 0; w < g_win_count; w++) {
+        dst->emerg_win[w] += src->emerg_win[w];
+        dst->crash_win[w] += src->crash_win[w];
+    }
+    dst->invalid += src->invalid;
+}
+
+// 누적 개수가 p 비율에 처음 도달하는 칸
+int percentile(const Dist *d, double p) {
+    uint64_t target = (uint64_t)(p * d->count + 0.999999);
+    if (target == 0)
+        target = 1;
+    uint64_t acc = 0;
+    for (int b = 0; b < HIST_BINS; b++) {
+        acc += d->bins[b];
+        if (acc >= target)
+            return b;
+    }
+    return HIST_BINS - 1;
+}
+
+void print_dists(const char *title, const char *label, const Dist *d, int n) {
+    printf("====[%s]====\n", title);
+    printf("%-4s %10s %10s %6s %6s %6s %6s\n", label, "count", "mean", "p50", "p90", "p99", "max");
+    for (int i = 0; i < n; i++) {
+        if (d[i].count == 0) {
+            printf("%-4d %10d %10s %6s %6s %6s %6s\n", i + (label[0] == 'R'), 0, "-", "-", "-", "-", "-");
+            continue;
+        }
+        printf("%-4d %10llu %10.3f %6d %6d %6d %6d\n", i + (label[0] == 'R'), (unsigned long long)d[i].count,
+               (double)d[i].sum / d[i].count, percentile(&d[i], 0.5), percentile(&d[i], 0.9),
+               percentile(&d[i], 0.99), d[i].max);
+    }
+}
+
+int main(int argc, char **argv) {
+    const char *path = (argc > 1) ? argv[1] : DEFAULT_TRACE_PATH;
+    g_window = (argc > 2) ? atoi(argv[2]) : DEFAULT_WINDOW;
+    int thread_count = (argc > 3) ? atoi(argv[3]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (g_window <= 0)
+        g_window = DEFAULT_WINDOW;
+    if (thread_count <= 0)
+        thread_count = 1;
+    if (thread_count > MAX_THREADS)
+        thread_count = MAX_THREADS;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        printf("open failed: %s\n", path);
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(TraceHeader)) {
+        printf("not a trace file: %s\n", path);
+        close(fd);
+        return -1;
+    }
+    size_t size = st.st_size;
+    const char *base = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        printf("mmap failed.\n");
+        return -1;
+    }
+
+    g_hdr = (const TraceHeader *)base;
+    const TraceHeader *h = g_hdr;
+    if (memcmp(h->magic, TRACE_MAGIC, sizeof(h->magic)) != 0 || h->version != TRACE_VERSION ||
+        h->header_size != sizeof(TraceHeader) || h->landing_q_count <= 0 || h->takeoff_q_count <= 0 ||
+        h->runway_count <= 0 || h->simulation_done <= 0) {
+        printf("unsupported trace format.\n");
+        munmap((void *)base, size);
+        return -1;
+    }
+    g_win_count = h->simulation_done / g_window + 1;
+
+    double start_time = now_sec();
+
+    //// 블록 목록 (헤더만 따라감: 블록 수만큼만 접근)
+    long cap = 1024;
+    g_blocks = malloc(sizeof(TraceBlock *) * cap);
+    if (g_blocks == NULL) {
+        printf("out of memory.\n");
+        munmap((void *)base, size);
+        return -1;
+    }
+    g_block_count = 0;
+    size_t off = h->header_size;
+    while (off + sizeof(TraceBlock) <= size) {
+        const TraceBlock *b = (const TraceBlock *)(base + off);
+        if (b->type >= TRACE_TYPE_COUNT || b->count == 0 || b->count > h->block_events ||
+            b->cols != (uint32_t)trace_cols[b->type] || b->stride != TRACE_COL_STRIDE(b->count) ||
+            off + trace_block_bytes(b) > size) {
+            printf("broken block at offset %zu (ignore the rest)\n", off);
+            break;
+        }
+        if (g_block_count == cap) {
+            const TraceBlock **grown = realloc(g_blocks, sizeof(TraceBlock *) * cap * 2);
+            if (grown == NULL) { // 기존 목록은 그대로 남음
+                printf("out of memory.\n");
+                free(g_blocks);
+                munmap((void *)base, size);
+                return -1;
+            }
+            g_blocks = grown;
+            cap *= 2;
+        }
+        g_blocks[g_block_count++] = b;
+        off += trace_block_bytes(b);
+    }
+    madvise((void *)base, off, MADV_WILLNEED); // 스레드들이 여기저기 동시에 읽음
+
+    //// 병렬 집계
+    Stats stats[MAX_THREADS];
+    pthread_t tids[MAX_THREADS];
+    atomic_init(&g_next_block, 0);
+    if (thread_count > g_block_count)
+        thread_count = g_block_count > 0 ? (int)g_block_count : 1;
+    for (int t = 1; t < thread_count; t++) {
+        if (pthread_create(&tids[t], NULL, go_scan, &stats[t]) != 0) {
+            // 이미 띄운 스레드 수만큼만 사용 (남은 블록은 main이 이어서 처리)
+            printf("pthread_create failed. (threads: %d)\n", t);
+            thread_count = t;
+            break;
+        }
+    }
+    int failed = (go_scan(&stats[0]) == NULL); // main도 같이 처리
+    for (int t = 1; t < thread_count; t++) {
+        void *ret;
+        pthread_join(tids[t], &ret);
+        if (ret == NULL)
+            failed = 1;
+        else if (!failed)
+            merge_stats(&stats[0], &stats[t]);
+    }
+    if (failed) {
+        printf("out of memory.\n");
+        return -1;
+    }
+    double scan_time = now_sec() - start_time;
+
+    //// 출력
+    Stats *s = &stats[0];
+    printf("====[trace]====\n");
+    printf("Seed: %llu, Replication: %u\n", (unsigned long long)h->seed, h->replication);
+    printf("LANDING_Q_COUNT: %d, TAKEOFF_Q_COUNT: %d, RUNWAY_COUNT: %d, TAKEOFF_ONLY: %d\n", h->landing_q_count,
+           h->takeoff_q_count, h->runway_count, h->takeoff_only);
+    printf("Blocks: %ld, Size: %.1f MB, Threads: %d, Scan: %.6f sec\n", g_block_count, size / 1e6, thread_count,
+           scan_time);
+    if (s->invalid)
+        printf("Invalid queue/runway idx: %llu\n", (unsigned long long)s->invalid);
+
+    print_dists("landing latency by queue", "Q", s->landing_q, h->landing_q_count);
+    print_dists("takeoff latency by queue", "Q", s->takeoff_q, h->takeoff_q_count);
+    print_dists("landing latency by runway", "RW", s->landing_rw, h->runway_count);
+    print_dists("takeoff latency by runway", "RW", s->takeoff_rw, h->runway_count);
+
+    printf("====[emergency / crash per %d ticks]====\n", g_window);
+    printf("%-13s %10s %10s %12s\n", "tick", "emergency", "crashed", "emerg:crash");
+    uint64_t total_emerg = 0, total_crash = 0;
+    for (int w = 0; w < g_win_count; w++) {
+        uint64_t e = s->emerg_win[w], c = s->crash_win[w];
+        total_emerg += e;
+        total_crash += c;
+        if (e == 0 && c == 0)
+            continue;
+        char range[32];
+        snprintf(range, sizeof(range), "%d~%d", w * g_window, (w + 1) * g_window - 1);
+        if (c == 0)
+            printf("%-13s %10llu %10llu %12s\n", range, (unsigned long long)e, (unsigned long long)c, "-");
+        else
+            printf("%-13s %10llu %10llu %12.3f\n", range, (unsigned long long)e, (unsigned long long)c,
+                   (double)e / c);
+    }
+    printf("%-13s %10llu %10llu\n", "total", (unsigned long long)total_emerg, (unsigned long long)total_crash);
+
+    free(g_blocks);
+    munmap((void *)base, size);
+    return 0;
+}
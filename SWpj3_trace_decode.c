@@ -0,0 +1,147 @@
+// 바이너리 트레이스 (SWpj3_trace.h) 를 mmap 해서 시뮬레이션 종료 요약을 다시 계산
+// 사용법: ./trace_decode [airplane_trace.bin]
+// >> 시뮬레이션을 다시 돌리거나 텍스트 로그를 파싱하지 않고 열만 훑어서 집계
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "SWpj3_trace.h"
+
+#define DEFAULT_TRACE_PATH "airplane_trace.bin"
+
+// 종류별 집계
+typedef struct TraceSum {
+    uint64_t events[TRACE_TYPE_COUNT];
+    int64_t landing_wait; // 일반 착륙 대기 시간 합
+    int64_t takeoff_wait; // 이륙 대기 시간 합
+    int last_tick;        // 마지막 tick 레코드
+    int total_planes;     // 마지막 tick 기준 생성 비행기 수
+    int landing_qsize;    // 마지막 tick 기준 큐 길이
+    int takeoff_qsize;
+    uint64_t blocks;
+} TraceSum;
+
+// 열 합 (컴파일러 자동 벡터화 대상)
+int64_t sum_col(const int32_t *col, uint32_t n) {
+    int64_t sum = 0;
+    for (uint32_t i = 0; i < n; i++)
+        sum += col[i];
+    return sum;
+}
+
+// 블록 1개 집계
+void sum_block(TraceSum *s, const TraceBlock *b) {
+    s->events[b->type] += b->count;
+    s->blocks++;
+
+    switch (b->type) {
+    case TRACE_TICK: {
+        // tick 레코드는 순서대로 기록됨 > 마지막 값이 최종 상태
+        uint32_t last = b->count - 1;
+        const int32_t *tick = trace_col(b, TT_TICK);
+        if (tick[last] > s->last_tick) {
+            s->last_tick = tick[last];
+            s->total_planes = trace_col(b, TT_TOTAL_PLANES)[last];
+            s->landing_qsize = trace_col(b, TT_LANDING_QSIZE)[last];
+            s->takeoff_qsize = trace_col(b, TT_TAKEOFF_QSIZE)[last];
+        }
+        break;
+    }
+    case TRACE_LANDING:
+        s->landing_wait += sum_col(trace_col(b, TL_WAIT), b->count);
+        break;
+    case TRACE_TAKEOFF:
+        s->takeoff_wait += sum_col(trace_col(b, TO_WAIT), b->count);
+        break;
+    default:
+        break; // 긴급/추락은 개수만 사용
+    }
+}
+
+int main(int argc, char **argv) {
+    const char *path = (argc > 1) ? argv[1] : DEFAULT_TRACE_PATH;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        printf("open failed: %s\n", path);
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(TraceHeader)) {
+        printf("not a trace file: %s\n", path);
+        close(fd);
+        return -1;
+    }
+    size_t size = st.st_size;
+    const char *base = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // 매핑은 fd를 닫아도 유지됨
+    if (base == MAP_FAILED) {
+        printf("mmap failed.\n");
+        return -1;
+    }
+    madvise((void *)base, size, MADV_SEQUENTIAL); // 앞에서부터 한 번만 읽음
+
+    const TraceHeader *h = (const TraceHeader *)base;
+    if (memcmp(h->magic, TRACE_MAGIC, sizeof(h->magic)) != 0 || h->version != TRACE_VERSION ||
+        h->header_size != sizeof(TraceHeader)) {
+        printf("unsupported trace format.\n");
+        munmap((void *)base, size);
+        return -1;
+    }
+
+    //// 블록 순회
+    TraceSum s;
+    memset(&s, 0, sizeof(s));
+    size_t off = h->header_size;
+    while (off + sizeof(TraceBlock) <= size) {
+        const TraceBlock *b = (const TraceBlock *)(base + off);
+        if (b->type >= TRACE_TYPE_COUNT || b->count == 0 || b->count > h->block_events ||
+            b->cols != (uint32_t)trace_cols[b->type] || b->stride != TRACE_COL_STRIDE(b->count) ||
+            off + trace_block_bytes(b) > size) {
+            printf("broken block at offset %zu (ignore the rest)\n", off);
+            break;
+        }
+        sum_block(&s, b);
+        off += trace_block_bytes(b);
+    }
+
+    printf("====[trace]====\n");
+    printf("Seed: %llu, Replication: %u\n", (unsigned long long)h->seed, h->replication);
+    printf("LANDING_Q_COUNT: %d, TAKEOFF_Q_COUNT: %d, RUNWAY_COUNT: %d, TAKEOFF_ONLY: %d\n", h->landing_q_count,
+           h->takeoff_q_count, h->runway_count, h->takeoff_only);
+    printf("Ticks: %d / %d, Blocks: %llu\n", s.last_tick, h->simulation_done, (unsigned long long)s.blocks);
+    // 헤더의 이벤트 수는 정상 종료 시에만 기록됨
+    for (int t = 0; t < TRACE_TYPE_COUNT; t++) {
+        if (h->event_count[t] != s.events[t]) {
+            printf("header event count mismatch (simulation did not finish?)\n");
+            break;
+        }
+    }
+
+    int emergency = (int)s.events[TRACE_EMERGENCY];
+    int crashed = (int)s.events[TRACE_CRASHED];
+    printf("\n\n=============[ Simulation is done! Let's check it out! ]=============\n");
+    printf("[Total Emergency Landed]: %d\n", emergency);
+    printf("[Total Crashed Planes] %d\n", crashed);
+    if (s.total_planes == 0)
+        printf("g_total_plane_count == 0.\n");
+    else {
+        printf("[Avg Emergency Landed] %lf\n", ((double)emergency / s.total_planes * 100.0));
+        printf("[Avg Crashed Planes] %lf\n ", ((double)crashed / s.total_planes * 100.0));
+    }
+
+    printf("\n[Total Planes] %d, [Landed] %llu, [Takeoff] %llu\n", s.total_planes,
+           (unsigned long long)s.events[TRACE_LANDING], (unsigned long long)s.events[TRACE_TAKEOFF]);
+    if (s.events[TRACE_LANDING] != 0)
+        printf("[Avg Landing Latency] %lf\n", (double)s.landing_wait / s.events[TRACE_LANDING]);
+    if (s.events[TRACE_TAKEOFF] != 0)
+        printf("[Avg Takeoff Latency] %lf\n", (double)s.takeoff_wait / s.events[TRACE_TAKEOFF]);
+    printf("[Remaining Queue Size] landing: %d, takeoff: %d\n", s.landing_qsize, s.takeoff_qsize);
+
+    munmap((void *)base, size);
+    return 0;
+}